@@ -11,6 +11,7 @@ public:
     float update(float val) {
         if (!started) {
             value = val;
+            started = true;
         } else {
             value = (alpha * val) + (1 - alpha) * value;
         }
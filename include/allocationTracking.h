@@ -0,0 +1,81 @@
+#ifndef allocationtracking_h
+#define allocationtracking_h
+
+/* Project Scope */
+#include "instrumentation.h"
+
+/* C++ Standard Library */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Heap allocation accounting.
+ *
+ * The global operator new/delete are replaced (in allocationTracking.cpp) with versions that count every allocation
+ * against the subsystem tagged on the calling thread. Code tags itself with a ScopeTag for as long as it runs, and
+ * anything untagged is counted as 'other'. Each block records its subsystem in a small header, so it is freed against
+ * the same subsystem wherever the free happens, and allocations - frees is the subsystem's live block count.
+ */
+namespace alloc {
+
+enum class Subsystem : uint8_t { other, mode, effect, audio, display, count };
+
+constexpr std::size_t subsystemCount = static_cast<std::size_t>(Subsystem::count);
+
+const char* subsystemName(Subsystem subsystem);
+
+// Tags heap allocations made by this thread with a subsystem while in scope. Tags nest, innermost wins.
+class ScopeTag {
+public:
+    explicit ScopeTag(Subsystem subsystem);
+    ~ScopeTag();
+    ScopeTag(const ScopeTag&) = delete;
+    void operator=(const ScopeTag&) = delete;
+
+private:
+    Subsystem previous;
+};
+
+struct Counters {
+    uint32_t allocations;
+    uint32_t frees;
+    uint32_t bytes;
+};
+
+// Running totals since startup
+Counters getCounters(Subsystem subsystem);
+Counters getTotalCounters();
+
+/**
+ * @brief Turns the running allocation totals into per-frame statistics for the timing report.
+ */
+class AllocationMonitor : public Instrumented {
+public:
+    AllocationMonitor();
+    // Record the allocations made since the previous call as one frame.
+    void endFrame();
+
+    // Instrumentation
+    std::vector<InstrumentationTrace*> getInstrumentation() override final;
+
+private:
+    std::array<Counters, subsystemCount> countersLastFrame{};
+    uint32_t bytesLastFrame{0};
+
+    // Instrumentation
+    std::vector<InstrumentationTrace> traceAllocations;
+    InstrumentationTrace traceBytes{"Allocated - All (bytes)"};
+};
+
+class AllocationMonitorSingleton {
+public:
+    static AllocationMonitor& get();
+    AllocationMonitorSingleton(const AllocationMonitorSingleton&) = delete;
+    void operator=(const AllocationMonitorSingleton&) = delete;
+};
+
+} // namespace alloc
+
+#endif // allocationtracking_h
@@ -4,14 +4,16 @@
 /* Project Scope */
 #include "FMTWrapper.h"
 #include "audio/audio.h"
+#include "audio/analyzer.h"
+#include "audio/blockTimestamps.h"
 #include "instrumentation.h"
+#include "spscRing.h"
+#include "tasks.h"
 #include "utility.h"
 
 /* Libraries */
-#include "arduinoFFT.h"
 #include <TAS5822.h>
 #include <etl/array.h>
-#include <etl/circular_buffer.h>
 
 /* C++ Standard Library */
 #include <memory>
@@ -20,7 +22,6 @@ inline void avrc_metadata_callback(uint8_t id, const uint8_t* text) {
     printing::print(fmt::format("==> AVRC metadata rsp: attribute id {:#X}, {}\n", id, (char*)(text)));
 }
 
-// class ArduinoFFT;
 class BluetoothA2DPSink;
 namespace audio_tools {
 class I2SStream;
@@ -37,11 +38,8 @@ public:
     void begin() override final;
     void update() override final;
     void a2dp_callback(const uint8_t* data, uint32_t length) override final;
-    void lockMutex() override final;
-    void releaseMutex() override final;
-    etl::icircular_buffer<AudioCharacteristics>& getAudioCharacteristicsHistory() override final {
-        return *audioCharacteristics;
-    }
+    const AudioHistory& getAudioCharacteristicsHistory() const override final { return *audioCharacteristics; }
+    analysis::BeatEventQueue& getBeatEvents() override final { return analyzer.getBeatEvents(); }
 
     // Instrumentation
     std::vector<InstrumentationTrace*> getInstrumentation() override final;
@@ -49,24 +47,21 @@ public:
     void audioProcessingTask();
 
 private:
-    std::unique_ptr<ArduinoFFT<float>> FFT;
     std::unique_ptr<BluetoothA2DPSink> a2dpSink;
     std::unique_ptr<audio_tools::I2SStream> i2sOutput;
-    float vReal[fftSamples];
-    float vImag[fftSamples];
-    float weighingFactors[fftSamples];
-
-    SemaphoreHandle_t audioCharacteristicsSemaphore;
+    analysis::AudioAnalyzer analyzer;
 
     uint32_t statReportInterval = 5000;
     uint32_t statReportLastTime = 0;
 
-    AudioCharacteristics* acBuf;
-    etl::icircular_buffer<AudioCharacteristics>* audioCharacteristics;
+    void* acBuf;
+    AudioHistory* audioCharacteristics;
 
-    std::size_t audioBufferSize = 8192;
+    // Written by the A2DP callback, read by the audio processing task
+    std::size_t audioBufferSize = 16384;
     int16_t* audioBufferRaw;
-    etl::icircular_buffer<int16_t>* audioBuffer;
+    std::unique_ptr<SpscRing<int16_t>> audioBuffer;
+    BlockTimestamps blockTimestamps;
 
     // Amplifier
     std::unique_ptr<TAS5822::TAS5822<TwoWire>> amplifier;
@@ -75,11 +70,9 @@ private:
     InstrumentationTrace traceCallbackTotal{"Audio Callback - Overall"};
     InstrumentationTrace traceCallbackI2S{"Audio Callback - I2S"};
     InstrumentationTrace traceCallbackBuffer{"Audio Callback - Buffer Fill"};
-    InstrumentationTrace traceProcessVol{"Audio Processing - Vol"};
-    InstrumentationTrace traceProcessFFT{"Audio Processing - FFT"};
-    InstrumentationTrace traceProcessSpectrum{"Audio Processing - Spectrum"};
     std::vector<InstrumentationTrace*> traces;
 
+    tasks::TaskStats& taskStats = tasks::TaskMonitorSingleton::get().add(tasks::config::audio);
     TaskHandle_t audioProcessingTaskHandle = nullptr;
 };
 
@@ -0,0 +1,96 @@
+#ifndef audio_analysis_h
+#define audio_analysis_h
+
+/* Project Scope */
+#include "EMA.h"
+#include "audio/audio.h"
+#include "audio/fft.h"
+#include "runningStatistics.h"
+
+/* Libraries */
+#include <etl/array.h>
+#include <etl/span.h>
+
+/* C++ Standard Library */
+#include <cstdint>
+
+/**
+ * Building blocks of the audio analysis, in a float and a fixed-point flavour.
+ *
+ * The float path is used by default. Define PIXELCLOCK_AUDIO_FIXED_POINT to build the audio backends with the
+ * fixed-point path instead, which halves the FFT memory and avoids floating point in the per-sample and per-bin loops
+ * (useful on parts without a fast FPU). Both paths are always compiled so they can be compared in tests.
+ */
+namespace analysis {
+
+using Spectrum = etl::array<float, audioSpectrumBins>;
+
+// Interleaved L/R samples, possibly split in two where they wrap around the end of a ring buffer. Each part holds
+// whole L/R pairs.
+struct SampleView {
+    SampleView(etl::span<const int16_t> first, etl::span<const int16_t> second = {}) : first(first), second(second) {}
+    template <typename Container> SampleView(const Container& c) : first(c.data(), c.size()) {}
+
+    std::size_t size() const { return first.size() + second.size(); }
+
+    etl::span<const int16_t> first;
+    etl::span<const int16_t> second;
+};
+
+struct Volume {
+    float left;  // RMS dBFS
+    float right; // RMS dBFS
+};
+
+/* Float path */
+
+// Mix interleaved L/R samples down to mono FFT input and measure the RMS volume of each channel, in a single pass.
+// Any of 'mono' beyond the end of the input is zero-filled.
+Volume mixDown(const SampleView& interleaved, etl::span<float> mono);
+// Sum FFT magnitudes into display bins through the precomputed bin map (see binMapping.h), ignoring FFT bins quieter
+// than 2% of 'prevMax'
+void binSpectrum(etl::span<const float> magnitudes, float prevMax, Spectrum& spectrum);
+
+/* Fixed-point path */
+
+Volume mixDown(const SampleView& interleaved, etl::span<int16_t> mono);
+void binSpectrum(etl::span<const uint32_t> magnitudes, float prevMax, Spectrum& spectrum);
+
+/* Running statistics */
+
+// The EMA weight per hop that smooths as much over a window's worth of hops as 'windowAlpha' does once per window
+float perHopAlpha(float windowAlpha);
+
+// Statistics over the audio history, updated once per analysed chunk rather than recomputed from the history
+class AudioStatistics {
+public:
+    // Mean spectrumMax over the last audioHistorySize chunks, or 0 before the first
+    float getAverageSpectrumMax() const { return spectrumMax.getMean(); }
+
+    // Folds 'c' into the statistics and fills in its running statistics fields. Call once per chunk, before
+    // publishing it.
+    void update(AudioCharacteristics& c);
+
+private:
+    utility::RunningSum<float, audioHistorySize> spectrumMax;
+    // 0.8 per non-overlapping window, applied once per hop
+    utility::EMA volumeLeft{perHopAlpha(0.8f)};
+    utility::EMA volumeRight{perHopAlpha(0.8f)};
+    utility::RunningMinMax<float, audioHistorySize> volume;
+};
+
+/* Compile-time selection */
+
+#ifdef PIXELCLOCK_AUDIO_FIXED_POINT
+using FFTSample = int16_t;
+using FFTMagnitude = uint32_t;
+using FFT = RealFFTQ15;
+#else
+using FFTSample = float;
+using FFTMagnitude = float;
+using FFT = RealFFT;
+#endif
+
+} // namespace analysis
+
+#endif // audio_analysis_h
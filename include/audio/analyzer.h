@@ -0,0 +1,63 @@
+#ifndef audio_analyzer_h
+#define audio_analyzer_h
+
+/* Project Scope */
+#include "audio/analysis.h"
+#include "audio/audio.h"
+#include "audio/beatTracker.h"
+#include "audio/blockTimestamps.h"
+#include "instrumentation.h"
+#include "memoryPlacement.h"
+#include "spscRing.h"
+
+/* C++ Standard Library */
+#include <cstdint>
+#include <vector>
+
+namespace analysis {
+
+/**
+ * @brief The audio analysis pipeline, shared by all audio backends.
+ *
+ * Turns windows of interleaved L/R samples into AudioCharacteristics: mono mixdown and volume, FFT, binning into the
+ * display spectrum, beat tracking, auto-gain and running statistics. Backends only capture samples into a ring and
+ * call process() from their analysis thread, so the analysis can be tested and benchmarked on desktop exactly as it
+ * runs on the device.
+ */
+class AudioAnalyzer : public Instrumented {
+public:
+    AudioAnalyzer() = default;
+    AudioAnalyzer(const AudioAnalyzer&) = delete;
+    void operator=(const AudioAnalyzer&) = delete;
+
+    // Analyses each full window waiting in 'samples', sliding forward one hop at a time, and publishes the results to
+    // 'history'. 'timestamps' holds the arrival times of the blocks in 'samples'. 'timeMs' is the time of the newest
+    // window, and each earlier one is stamped a hop before the next, so beat events in a batch keep their spacing.
+    // Returns true if any beat events were published.
+    bool process(SpscRing<int16_t>& samples, BlockTimestamps& timestamps, AudioHistory& history, uint32_t timeMs);
+
+    // Analyses one window of audioWindowSamples interleaved L/R samples. The result's captureTimeUs is left at 0.
+    AudioCharacteristics analyse(const SampleView& window, uint32_t timeMs);
+
+    BeatEventQueue& getBeatEvents() { return beatTracker.getEvents(); }
+
+    // Instrumentation
+    std::vector<InstrumentationTrace*> getInstrumentation() override final;
+
+private:
+    FFT fft{fftSamples};
+    // Written and read once per chunk, in order, so they can live in PSRAM
+    memory::PlacedVector<FFTSample> fftInput{fftSamples, {memory::Placement::bulk, "FFT input"}};
+    memory::PlacedVector<FFTMagnitude> fftMagnitudes{fftSamples / 2, {memory::Placement::bulk, "FFT magnitudes"}};
+    AudioStatistics statistics;
+    BeatTracker beatTracker{audioHopsPerSecond};
+    float previousSpectrumMax = 0;
+
+    InstrumentationTrace traceMixDown{"Audio Analysis - Mixdown"};
+    InstrumentationTrace traceFFT{"Audio Analysis - FFT", InstrumentationTrace::Detail::percentiles};
+    InstrumentationTrace traceSpectrum{"Audio Analysis - Spectrum"};
+};
+
+} // namespace analysis
+
+#endif // audio_analyzer_h
@@ -2,11 +2,16 @@
 #define audio_audio_h
 
 /* Project Scope */
+#include "audio/beatTracker.h"
+#include "audio/binMapping.h"
 #include "instrumentation.h"
+#include "seqlockHistory.h"
 
 /* Libraries */
 #include <etl/array.h>
-#include <etl/circular_buffer.h>
+
+/* C++ Standard Library */
+#include <atomic>
 
 constexpr int fftSamples = 2048;
 constexpr int fftSampleFreq = 44100;
@@ -14,28 +19,62 @@ constexpr int fftBandwidth = fftSampleFreq / 2;                    // Bandwidth
 constexpr int fftPeriod = 1000 * fftSamples / fftSampleFreq;       // Duration / period of FFT (ms)
 constexpr int fftFrequencyResolution = fftSampleFreq / fftSamples; // Width of each measurement result (Hz)
 
+// Display bins are spaced evenly on audioSpectrumSpacing between the min and max frequencies (Hz)
 constexpr int audioSpectrumBins = 17;
-constexpr int audioSpectrumMaxFreq = 3000;
-constexpr int audioSpectrumBinWidth = audioSpectrumMaxFreq / audioSpectrumBins;
-constexpr int audioSpectrumBinSize = (fftSamples / 4) / audioSpectrumBins;
+constexpr analysis::BinSpacing audioSpectrumSpacing = analysis::BinSpacing::mel;
+constexpr int audioSpectrumMinFreq = 40;
+constexpr int audioSpectrumMaxFreq = 8000;
+
+// Short-time FFT framing. Each analysis window covers fftSamples stereo frames, and each new window starts
+// audioHopFrames after the previous one, so consecutive windows overlap by audioOverlapPercent.
+constexpr int audioOverlapPercent = 75; // 0, 50 or 75
+constexpr int audioHopFrames = fftSamples * (100 - audioOverlapPercent) / 100;
+constexpr int audioWindowSamples = fftSamples * 2;   // Interleaved L/R samples per window
+constexpr int audioHopSamples = audioHopFrames * 2; // Interleaved L/R samples per hop
+constexpr float audioHopsPerSecond = float(fftSampleFreq) / audioHopFrames;
 
-constexpr int audioHistorySize = 100;
+// History entries (one per hop) per fftSamples of audio. Lengths and rates counted in entries were tuned when each
+// entry covered a whole non-overlapping window, so they are scaled by this to keep the same durations on screen.
+constexpr int audioHopsPerWindow = fftSamples / audioHopFrames;
+
+constexpr int audioHistorySize = 100 * audioHopsPerWindow; // ~4.6 s
 
 struct AudioCharacteristics {
     float volumeLeft;  // Volume of last chunk left channel (RMS dBFS)
     float volumeRight; // Volume of last chunk right channel (RMS dBFS)
     float spectrumMax;
     etl::array<float, audioSpectrumBins> spectrum;
+
+    // Running statistics over the history, maintained by the audio side so renderers read them in O(1)
+    float volumeLeftSmoothed;  // EMA of volumeLeft (dBFS)
+    float volumeRightSmoothed; // EMA of volumeRight (dBFS)
+    float volumeMin;           // Quietest mean L/R volume in the last audioHistorySize chunks (dBFS)
+    float volumeMax;           // Loudest mean L/R volume in the last audioHistorySize chunks (dBFS)
+    uint32_t captureTimeUs; // micros() when the newest audio in this chunk arrived in the audio callback
 };
 
+// Published by the audio processing side, read by renderers without blocking it
+using AudioHistory = SeqlockHistory<AudioCharacteristics, audioHistorySize>;
+
 class Audio : public Instrumented {
 public:
     virtual void begin() = 0;
     virtual void update() = 0;
     virtual void a2dp_callback(const uint8_t* data, uint32_t length) = 0;
-    virtual void lockMutex() = 0;
-    virtual void releaseMutex() = 0;
-    virtual etl::icircular_buffer<AudioCharacteristics>& getAudioCharacteristicsHistory() = 0;
+    virtual const AudioHistory& getAudioCharacteristicsHistory() const = 0;
+    // Beat and onset events from the audio side. Drain from the render loop only (e.g. with analysis::BeatSync).
+    virtual analysis::BeatEventQueue& getBeatEvents() = 0;
+
+    // Called on the audio side whenever new beat events are published, e.g. to wake the render loop
+    void setEventCallback(void (*callback)()) { eventCallback.store(callback, std::memory_order_release); }
+
+protected:
+    void notifyEvents() {
+        if (auto callback = eventCallback.load(std::memory_order_acquire)) { callback(); }
+    }
+
+private:
+    std::atomic<void (*)()> eventCallback{nullptr};
 };
 
 class AudioSingleton {
@@ -0,0 +1,115 @@
+#ifndef audio_beatTracker_h
+#define audio_beatTracker_h
+
+/* Project Scope */
+#include "frameContext.h"
+#include "runningStatistics.h"
+#include "spscRing.h"
+
+/* Libraries */
+#include <etl/span.h>
+
+/* C++ Standard Library */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace analysis {
+
+struct BeatEvent {
+    enum class Type : uint8_t { onset, beat };
+
+    Type type;
+    uint32_t timeMs; // When the event happened, on the millis() timebase
+    float strength;  // onset: spectral flux relative to the detection threshold. beat: tempo confidence [0, 1]
+    float bpm;       // Tempo estimate at the time, 0 if unknown
+    float phase;     // Position within the beat at the time, [0, 1). Always 0 for beats.
+};
+
+using BeatEventQueue = SpscRing<BeatEvent>;
+
+/**
+ * @brief Spectral-flux onset detection and tempo tracking, fed one analysed chunk at a time.
+ *
+ * Onsets are peaks in the spectral flux (the summed increase in log magnitude across the display bins since the
+ * previous chunk) that rise above an adaptive threshold. The tempo is re-estimated periodically from the
+ * autocorrelation of the recent flux, with a mild preference for tempos near 120 BPM to avoid octave errors. A phase
+ * oscillator runs at that tempo and is pulled towards each onset that lands near a beat, and a beat event is emitted
+ * each time it wraps.
+ *
+ * update() runs on the audio side and is the single producer of the event queue; the render side drains it, usually
+ * through BeatSync.
+ */
+class BeatTracker {
+public:
+    // 'chunksPerSecond' is the rate update() is called at, i.e. the STFT hop rate
+    explicit BeatTracker(float chunksPerSecond);
+    BeatTracker(const BeatTracker&) = delete;
+    void operator=(const BeatTracker&) = delete;
+
+    // Feed the unscaled display spectrum of one chunk, analysed at 'timeMs'
+    void update(etl::span<const float> spectrum, uint32_t timeMs);
+
+    BeatEventQueue& getEvents() { return events; }
+    // Events published so far, including any dropped because the queue was full. Audio side only.
+    uint32_t getPublishedCount() const { return published; }
+
+    // Audio side only
+    float getBpm() const { return bpm; }
+    float getPhase() const { return phase; }
+
+private:
+    static constexpr std::size_t maxBins = 32;
+    static constexpr std::size_t envelopeLength = 512; // ~6 s of flux at the default hop rate
+    static constexpr std::size_t thresholdLength = 32; // ~0.4 s
+    static constexpr std::size_t tempoInterval = 16;   // chunks between tempo estimates
+
+    void estimateTempo();
+    void publish(BeatEvent::Type type, uint32_t timeMs, float strength, float eventPhase);
+
+    const float chunksPerSecond;
+
+    std::array<float, maxBins> previousLog{};
+    std::array<float, envelopeLength> envelope{};
+    std::size_t envelopeNext = 0;
+    uint32_t chunkCount = 0;
+
+    utility::RunningSum<float, thresholdLength> fluxAverage;
+    float fluxBefore = 0; // flux two chunks ago
+    float fluxLast = 0;   // flux one chunk ago
+    uint32_t lastTimeMs = 0;
+    uint32_t lastOnsetMs = 0;
+    bool onsetSeen = false;
+
+    float bpm = 0;
+    float confidence = 0;
+    float phase = 0;
+    bool phaseLocked = false;
+
+    uint32_t published = 0;
+    std::array<BeatEvent, 32> eventStorage{};
+    BeatEventQueue events{eventStorage.data(), eventStorage.size()};
+};
+
+/**
+ * @brief Render-side consumer of the beat events, filling in the music sync fields of each FrameContext.
+ *
+ * Between events the beat phase is extrapolated from the last beat and the tempo, so effects see a smoothly advancing
+ * phase at the frame rate rather than at the audio chunk rate. The tracker sends nothing when it loses the tempo (in
+ * silence, say), so once lostAfterBeats beat periods pass without a beat the tempo reverts to unknown.
+ */
+class BeatSync {
+public:
+    static constexpr float lostAfterBeats = 4;
+
+    void apply(BeatEventQueue& events, FrameContext& frame);
+
+private:
+    float bpm = 0;
+    uint32_t lastBeatMs = 0;
+    bool beatSeen = false;
+};
+
+} // namespace analysis
+
+#endif // audio_beatTracker_h
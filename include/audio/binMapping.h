@@ -0,0 +1,185 @@
+#ifndef audio_binMapping_h
+#define audio_binMapping_h
+
+/* C++ Standard Library */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Compile-time mapping from FFT bins to display bins.
+ *
+ * The display range is split into bins that are evenly spaced on a perceptual scale (log, mel or bark) rather than in
+ * Hz, so each column covers a similar share of what is heard. The resulting edges are turned into a sparse table of
+ * (FFT bin, display bin, weight) entries: an FFT bin that straddles a display edge is shared between both display bins
+ * in proportion to its overlap, and weights are divided by the square root of the display bin's width so that pink
+ * noise (roughly the spectrum of music) reads flat across the display. Binning a spectrum is then a single
+ * multiply-accumulate per entry.
+ *
+ * std::log and friends are not constexpr in C++17, so the few functions needed are implemented here.
+ */
+namespace analysis {
+
+enum class BinSpacing { linear, log, mel, bark };
+
+namespace detail {
+
+constexpr double ln2 = 0.69314718055994530942;
+
+constexpr double cabs(double x) { return x < 0 ? -x : x; }
+
+constexpr double cln(double x) {
+    // x = m * 2^e with m in [1, 2), then ln(m) = 2 * atanh((m - 1) / (m + 1))
+    int e = 0;
+    while (x >= 2) {
+        x /= 2;
+        e++;
+    }
+    while (x < 1) {
+        x *= 2;
+        e--;
+    }
+    const double t = (x - 1) / (x + 1);
+    double term = t;
+    double sum = 0;
+    for (int k = 1; cabs(term) > 1e-17; k += 2) {
+        sum += term / k;
+        term *= t * t;
+    }
+    return 2 * sum + e * ln2;
+}
+
+constexpr double cexp(double x) {
+    // exp(x) = 2^k * exp(r) with |r| <= ln(2) / 2
+    int k = static_cast<int>(x / ln2 + (x < 0 ? -0.5 : 0.5));
+    const double r = x - k * ln2;
+    double term = 1;
+    double sum = 1;
+    for (int n = 1; cabs(term) > 1e-17; n++) {
+        term *= r / n;
+        sum += term;
+    }
+    for (; k > 0; k--) { sum *= 2; }
+    for (; k < 0; k++) { sum /= 2; }
+    return sum;
+}
+
+constexpr double csqrt(double x) {
+    if (x <= 0) { return 0; }
+    double r = x > 1 ? x : 1;
+    for (int i = 0; i < 100; i++) {
+        const double next = (r + x / r) / 2;
+        if (next >= r) { break; }
+        r = next;
+    }
+    return r;
+}
+
+} // namespace detail
+
+// Hz to a position on the given scale
+constexpr double toScale(BinSpacing spacing, double hz) {
+    switch (spacing) {
+    case BinSpacing::log:
+        return detail::cln(hz);
+    case BinSpacing::mel:
+        return 1127 * detail::cln(1 + hz / 700);
+    case BinSpacing::bark:
+        // Traunmüller's approximation
+        return 26.81 * hz / (1960 + hz) - 0.53;
+    default:
+        return hz;
+    }
+}
+
+// Inverse of toScale
+constexpr double fromScale(BinSpacing spacing, double value) {
+    switch (spacing) {
+    case BinSpacing::log:
+        return detail::cexp(value);
+    case BinSpacing::mel:
+        return 700 * (detail::cexp(value / 1127) - 1);
+    case BinSpacing::bark:
+        return 1960 * (value + 0.53) / (26.28 - value);
+    default:
+        return value;
+    }
+}
+
+// Bins + 1 edges in Hz, display bin b covering [edges[b], edges[b + 1])
+template <std::size_t Bins> using BinEdges = std::array<double, Bins + 1>;
+
+template <std::size_t Bins> constexpr BinEdges<Bins> makeBinEdges(BinSpacing spacing, double minHz, double maxHz) {
+    BinEdges<Bins> edges{};
+    const double low = toScale(spacing, minHz);
+    const double high = toScale(spacing, maxHz);
+    for (std::size_t b = 0; b <= Bins; b++) { edges[b] = fromScale(spacing, low + (high - low) * b / Bins); }
+    // pin the ends exactly, whatever rounding the round trip introduced
+    edges[0] = minHz;
+    edges[Bins] = maxHz;
+    return edges;
+}
+
+struct BinWeight {
+    uint16_t fftBin;
+    uint8_t displayBin;
+    float weight;
+    uint16_t weightQ15; // the same weight in Q15, for integer magnitudes
+};
+
+template <std::size_t Entries> using BinMap = std::array<BinWeight, Entries>;
+
+namespace detail {
+
+// Calls f(fftBin, displayBin, overlap) for each FFT bin overlapping a display bin, in FFT bin order. FFT bin k covers
+// [(k - 0.5) * binHz, (k + 0.5) * binHz), and 'overlap' is the fraction of it inside the display bin.
+template <std::size_t Edges, typename Function>
+constexpr void forEachOverlap(const std::array<double, Edges>& edges, double binHz, std::size_t fftBins, Function f) {
+    constexpr std::size_t Bins = Edges - 1;
+    for (std::size_t k = 1; k < fftBins; k++) {
+        const double low = (k - 0.5) * binHz;
+        const double high = (k + 0.5) * binHz;
+        for (std::size_t b = 0; b < Bins; b++) {
+            const double from = low > edges[b] ? low : edges[b];
+            const double to = high < edges[b + 1] ? high : edges[b + 1];
+            if (to > from) { f(k, b, (to - from) / binHz); }
+        }
+    }
+}
+
+} // namespace detail
+
+// Number of entries makeBinMap will produce, to size its result
+template <std::size_t Edges>
+constexpr std::size_t countBinMapEntries(const std::array<double, Edges>& edges, double binHz, std::size_t fftBins) {
+    std::size_t count = 0;
+    detail::forEachOverlap(edges, binHz, fftBins, [&](std::size_t, std::size_t, double) { count++; });
+    return count;
+}
+
+// Sparse mapping from 'fftBins' FFT bins of 'binHz' each onto the display bins given by 'edges', sorted by FFT bin
+template <std::size_t Entries, std::size_t Edges>
+constexpr BinMap<Entries> makeBinMap(const std::array<double, Edges>& edges, double binHz, std::size_t fftBins) {
+    constexpr std::size_t Bins = Edges - 1;
+    std::array<double, Bins> norm{};
+    for (std::size_t b = 0; b < Bins; b++) {
+        const double width = (edges[b + 1] - edges[b]) / binHz;
+        norm[b] = 1 / detail::csqrt(width > 1 ? width : 1);
+    }
+
+    BinMap<Entries> map{};
+    std::size_t i = 0;
+    detail::forEachOverlap(edges, binHz, fftBins, [&](std::size_t k, std::size_t b, double overlap) {
+        const double weight = overlap * norm[b];
+        map[i].fftBin = static_cast<uint16_t>(k);
+        map[i].displayBin = static_cast<uint8_t>(b);
+        map[i].weight = static_cast<float>(weight);
+        map[i].weightQ15 = static_cast<uint16_t>(weight * 32767 + 0.5);
+        i++;
+    });
+    return map;
+}
+
+} // namespace analysis
+
+#endif // audio_binMapping_h
@@ -0,0 +1,64 @@
+#ifndef audio_blockTimestamps_h
+#define audio_blockTimestamps_h
+
+/* Project Scope */
+#include "spscRing.h"
+
+/* C++ Standard Library */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Arrival times of the blocks of samples written to a sample ring, to find how old analysed audio is.
+ *
+ * The producer stamps each block just before writing it to the sample ring, and the consumer reports how many samples
+ * it has released from the ring. Both count samples from the first one ever written, so the consumer can look up the
+ * block that delivered any sample it is holding. Lookups must move forward through the stream, which lets stale stamps
+ * be discarded as they go. Stamps travel through their own SpscRing, so neither side ever blocks.
+ */
+class BlockTimestamps {
+public:
+    /* Producer */
+
+    // Call before writing 'count' samples that arrived at 'timeUs' to the sample ring
+    void written(std::size_t count, uint32_t timeUs) {
+        if (count == 0) { return; } // nothing fitted, so there is no block to stamp
+        producerTotal += count;
+        const Stamp stamp{producerTotal, timeUs};
+        // if the consumer is far behind, the stamp is dropped and its samples are attributed to an earlier block
+        stamps.write({&stamp, 1});
+    }
+
+    /* Consumer */
+
+    // Call after releasing 'count' samples from the sample ring
+    void consumed(std::size_t count) { consumerTotal += count; }
+
+    // Arrival time of the newest of the next 'count' unreleased samples
+    uint32_t arrivalOf(std::size_t count) {
+        const std::size_t target = consumerTotal + count;
+        while (!stamps.empty()) {
+            const Stamp stamp = stamps.peek(1).first[0];
+            latestUs = stamp.timeUs;
+            // compare by difference, so the running counts can wrap around
+            if (static_cast<std::ptrdiff_t>(stamp.end - target) >= 0) { break; }
+            stamps.skip(1);
+        }
+        return latestUs;
+    }
+
+private:
+    struct Stamp {
+        std::size_t end; // Running sample count at the end of the block
+        uint32_t timeUs;
+    };
+
+    std::array<Stamp, 64> storage{};
+    SpscRing<Stamp> stamps{storage.data(), storage.size()};
+    std::size_t producerTotal = 0;
+    std::size_t consumerTotal = 0;
+    uint32_t latestUs = 0;
+};
+
+#endif // audio_blockTimestamps_h
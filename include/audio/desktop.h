@@ -3,16 +3,21 @@
 
 #ifdef PIXELCLOCK_DESKTOP
 
+/* Arduino Core */
+#include <Arduino.h>
+
 /* Project Scope */
 #include "audio/audio.h"
+#include "audio/analyzer.h"
+#include "audio/blockTimestamps.h"
+#include "spscRing.h"
 
 /* Libraries */
 #include <SFML/Audio.hpp>
-#include <arduinoFFT.h>
 #include <etl/array.h>
-#include <etl/circular_buffer.h>
 
 /* C++ Standard Library */
+#include <array>
 #include <functional>
 #include <memory>
 
@@ -28,7 +33,7 @@ public:
     virtual void onStop() {}
 
     virtual bool onProcessSamples(const sf::Int16* samples, std::size_t sampleCount) {
-        if (callback) { callback((uint8_t*)(samples), sampleCount); }
+        if (callback) { callback((uint8_t*)(samples), sampleCount * sizeof(sf::Int16)); }
         return true;
     }
 
@@ -42,40 +47,38 @@ private:
 
 class AudioDesktop : public Audio {
 public:
-    AudioDesktop() {}
+    AudioDesktop() : audioSamplesBuffer(audioSamplesStorage.data(), audioSamplesStorage.size()) {}
     ~AudioDesktop() {
         if (recorder) { recorder->stop(); }
     }
 
-    void begin() override final;
-    void update() override final;
+    void begin() override;
+    void update() override;
     void a2dp_callback(const uint8_t* data, uint32_t length) override final;
-    void lockMutex() override final {}
-    void releaseMutex() override final {}
-    etl::icircular_buffer<AudioCharacteristics>& getAudioCharacteristicsHistory() override final {
-        return audioCharacteristics;
-    }
+    const AudioHistory& getAudioCharacteristicsHistory() const override final { return audioCharacteristics; }
+    analysis::BeatEventQueue& getBeatEvents() override final { return analyzer.getBeatEvents(); }
 
     // Instrumentation
     std::vector<InstrumentationTrace*> getInstrumentation() override final;
 
-private:
-    float vReal[fftSamples];
-    float vImag[fftSamples];
-    float weighingFactors[fftSamples];
+protected:
+    // Clocks used to timestamp audio blocks and beat events, on the micros() and millis() timebases
+    virtual uint32_t clockMicros() const { return micros(); }
+    virtual uint32_t clockMillis() const { return millis(); }
 
-    std::unique_ptr<ArduinoFFT<float>> FFT;
+private:
+    analysis::AudioAnalyzer analyzer;
 
     std::unique_ptr<SFMLRecorder> recorder;
 
-    etl::circular_buffer<AudioCharacteristics, audioHistorySize> audioCharacteristics;
+    AudioHistory audioCharacteristics;
 
-    etl::circular_buffer<int16_t, 8192> audioSamplesBuffer;
+    // Written by the SFML recorder thread, read by update()
+    std::array<int16_t, 16384> audioSamplesStorage;
+    SpscRing<int16_t> audioSamplesBuffer;
+    BlockTimestamps blockTimestamps;
 
     InstrumentationTrace traceCallbackTotal{"Audio Callback - Overall"};
-    InstrumentationTrace traceCallbackVolume{"Audio Callback - Vol"};
-    InstrumentationTrace traceCallbackFFT{"Audio Callback - FFT"};
-    InstrumentationTrace traceCallbackSpectrum{"Audio Callback - Spectrum"};
 };
 
 #endif
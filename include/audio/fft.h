@@ -0,0 +1,82 @@
+#ifndef audio_fft_h
+#define audio_fft_h
+
+/* Project Scope */
+#include "memoryPlacement.h"
+
+/* Libraries */
+#include <etl/span.h>
+
+/* C++ Standard Library */
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Magnitude spectrum of a real signal, computed with a half-length complex FFT.
+ *
+ * The N real input samples are packed into N/2 complex values (even samples as the real part, odd samples as the
+ * imaginary part), transformed with an N/2-point radix-2 FFT, then split back into the spectrum of the real signal.
+ * This does half the butterfly work of a complex N-point FFT with a zero imaginary part.
+ *
+ * DC removal and the Hamming window are applied while packing, and magnitudes are taken while splitting, so the data
+ * is only walked once before and once after the FFT. The window and twiddle factors are computed once on
+ * construction. The twiddles and working buffer are accessed with a stride on every butterfly stage and are kept in
+ * internal RAM; the window is only read sequentially and may go to PSRAM.
+ *
+ * On ESP32 the N/2-point FFT uses the ESP-DSP SIMD kernels when they are available; elsewhere a portable
+ * implementation is used.
+ */
+class RealFFT {
+public:
+    // 'size' (N) must be a power of two, at least 4
+    explicit RealFFT(std::size_t size);
+
+    std::size_t getSize() const { return size; }
+
+    // Writes the magnitude of bins [0, N/2) of 'input' (N samples) into 'magnitudes' (N/2 values). Magnitudes are
+    // unnormalised, so a sine of amplitude A centred on a bin reads as about 0.27 * A * N (0.54 window gain * N/2).
+    void magnitudes(etl::span<const float> input, etl::span<float> magnitudes);
+
+private:
+    void transform();
+
+    const std::size_t size;
+    memory::PlacedVector<float> window;
+    // cos/sin of -2*pi*k/N for k in [0, N/2). The N/2-point FFT uses the even entries.
+    memory::PlacedVector<float> twiddleRe;
+    memory::PlacedVector<float> twiddleIm;
+    // N/2 interleaved complex values (re, im, re, im...)
+    memory::PlacedVector<float> work;
+};
+
+/**
+ * @brief Fixed-point equivalent of RealFFT, working on Q15 samples with 16-bit storage throughout.
+ *
+ * Uses the same pack / N/2-point FFT / split structure. The window and twiddles are Q15, and the working buffer uses
+ * block floating point: before each butterfly stage the whole block is shifted down just enough that the stage cannot
+ * overflow, and the shifts are accumulated into an exponent that is applied to the final magnitudes. This keeps close
+ * to 16 bits of precision for both quiet and loud input while needing half the memory of the float version and no
+ * floating point arithmetic.
+ */
+class RealFFTQ15 {
+public:
+    // 'size' (N) must be a power of two, at least 4
+    explicit RealFFTQ15(std::size_t size);
+
+    std::size_t getSize() const { return size; }
+
+    // Same as RealFFT::magnitudes, on integer samples and with integer magnitudes in the same units.
+    void magnitudes(etl::span<const int16_t> input, etl::span<uint32_t> magnitudes);
+
+private:
+    // Runs the N/2-point FFT on 'work', returning how many bits the data was shifted down by along the way.
+    int transform(int16_t largest);
+
+    const std::size_t size;
+    memory::PlacedVector<int16_t> window;
+    memory::PlacedVector<int16_t> twiddleRe;
+    memory::PlacedVector<int16_t> twiddleIm;
+    memory::PlacedVector<int16_t> work;
+};
+
+#endif // audio_fft_h
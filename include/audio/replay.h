@@ -0,0 +1,72 @@
+#ifndef audio_replay_h
+#define audio_replay_h
+
+#ifdef PIXELCLOCK_DESKTOP
+
+/* Project Scope */
+#include "audio/desktop.h"
+
+/* C++ Standard Library */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Desktop audio source that plays a file through the normal capture path instead of a recording device.
+ *
+ * The file is either a WAV file (16-bit PCM, mono or stereo) or, for any other extension, raw interleaved 16-bit
+ * stereo PCM at fftSampleFreq. Samples are handed to a2dp_callback in blocks and analysed exactly as captured audio
+ * would be, so audio effects and the analysis path can be exercised on a machine without a microphone.
+ *
+ * In real time pacing, each update() feeds whatever the wall clock says is due, and playback loops. When as fast as
+ * possible, each update() feeds one fixed-size block and playback stops at the end of the file.
+ *
+ * Blocks and beat events are timestamped with micros() like captured audio, as the display compares them against the
+ * frame time. Tests can use the file clock instead, taking timestamps from the position in the file, so two runs over
+ * the same file publish identical results.
+ *
+ * On desktop, AudioSingleton uses this instead of the capture device when PIXELCLOCK_AUDIO_FILE is set; set
+ * PIXELCLOCK_AUDIO_PACING=fast for as fast as possible.
+ */
+class AudioReplay : public AudioDesktop {
+public:
+    enum class Pacing { realTime, asFastAsPossible };
+    enum class Clock { wall, file };
+
+    AudioReplay(
+        std::string path,
+        Pacing pacing,
+        Clock clock = Clock::wall,
+        std::size_t blockFrames = audioHopFrames);
+
+    void begin() override final;
+    void update() override final;
+
+    // True once the whole file has been fed (never, in real time pacing)
+    bool finished() const { return pacing == Pacing::asFastAsPossible && position >= samples.size(); }
+    // Position in the file, in microseconds
+    uint32_t getPositionUs() const;
+
+protected:
+    uint32_t clockMicros() const override final;
+    uint32_t clockMillis() const override final;
+
+private:
+    bool loadWav(const std::vector<uint8_t>& file);
+    void feed(std::size_t count);
+
+    const std::string path;
+    const Pacing pacing;
+    const Clock clock;
+    const std::size_t blockSamples;
+
+    std::vector<int16_t> samples; // interleaved L/R
+    std::size_t position = 0;     // next sample to feed
+    uint64_t fedTotal = 0;        // samples fed, including earlier loops
+    uint64_t elapsedUs = 0;       // wall time since begin(), kept in 64 bits as micros() wraps every ~71 minutes
+    uint32_t lastUs = 0;
+};
+
+#endif
+
+#endif // audio_replay_h
@@ -4,6 +4,7 @@
 /* Project Scope */
 #include "characters.h"
 #include "flm_pixeltypes.h"
+#include "frameArena.h"
 
 /* C++ Standard Library */
 #include <cstdint>
@@ -16,8 +17,12 @@ class Canvas {
 public:
     Canvas() : Canvas(0, 0) {}
     Canvas(int width, int height);
+    // Canvas with storage taken from the frame arena. Only valid until the end of the current frame; copies of it
+    // are allocated normally, but moves keep the arena storage, so keep it local and never return it.
+    Canvas(int width, int height, FrameArena& arena);
+    Canvas(const Canvas& other, FrameArena& arena);
 
-    using StorageType = std::vector<flm::CRGB>;
+    using StorageType = FrameVector<flm::CRGB>;
 
     int getWidth() const { return width; }
     int getHeight() const { return height; }
@@ -44,7 +49,7 @@ public:
     void showCharacter(char character, flm::CRGB colour, int xOffset);
     void showCharacter(const FontGlyph& character, flm::CRGB colour, int xOffset);
 
-    bool operator==(const Canvas& c2) { return (width == c2.width && height == c2.height && data == c2.data); }
+    bool operator==(const Canvas& c2) const { return (width == c2.width && height == c2.height && data == c2.data); }
 
 private:
     int width;
@@ -56,6 +61,7 @@ private:
 Canvas blit(const Canvas& background, const Canvas& foreground, int xOffset, int yOffset);
 
 Canvas crop(const Canvas& input, int startX, int startY, int width, int height);
+Canvas crop(const Canvas& input, int startX, int startY, int width, int height, FrameArena& arena);
 
 } // namespace canvas
 
@@ -3,6 +3,7 @@
 
 /* Project Scope */
 #include "flm_pixeltypes.h"
+#include "frameContext.h"
 #include "instrumentation.h"
 
 /* C++ Standard Library */
@@ -17,6 +18,8 @@ class Display : public Instrumented {
 public:
     virtual void setBrightness(uint8_t brightness) = 0;
     virtual void update(const canvas::Canvas& canvas) = 0;
+    // Shows 'canvas', drawn for 'frame'. Displays that measure output latency override this.
+    virtual void update(const canvas::Canvas& canvas, [[maybe_unused]] const FrameContext& frame) { update(canvas); }
     virtual uint8_t getWidth() const = 0;
     virtual uint8_t getHeight() const = 0;
     virtual uint32_t getSize() const = 0;
@@ -15,6 +15,7 @@ public:
     ~DummyDisplay(){};
     void setBrightness(uint8_t brightness) override final { this->brightness = brightness; }
     void update(const canvas::Canvas& canvas) override final { this->c = canvas; };
+    using Display::update;
     uint8_t getWidth() const override final { return width; }
     uint8_t getHeight() const override final { return height; }
     uint32_t getSize() const override final { return size; }
@@ -12,7 +12,7 @@
 class BouncingBall : public DisplayEffect {
 public:
     BouncingBall(const canvas::Canvas& size, uint32_t updateInterval, colourGenerator::Generator colourGenerator);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final;
 
@@ -23,6 +23,7 @@ private:
     int xDir;
     int yDir;
     uint32_t _lastLoopTime;
+    bool _restartTiming;
     uint32_t _updateInterval;
     colourGenerator::Generator _colourGenerator;
     bool _finished;
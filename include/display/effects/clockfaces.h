@@ -17,7 +17,7 @@ class ClockFace_Base : public DisplayEffect {
 public:
     ClockFace_Base(std::function<ClockFaceTimeStruct(void)> timeCallbackFunction)
         : timeCallbackFunction(timeCallbackFunction) {}
-    virtual canvas::Canvas run() override = 0;
+    virtual canvas::Canvas run(const FrameContext& frame) override = 0;
     virtual bool finished() const override = 0;
     virtual void reset() override = 0;
 
@@ -29,17 +29,19 @@ class ClockFace_Simple : public ClockFace_Base {
 public:
     ClockFace_Simple(std::function<ClockFaceTimeStruct(void)> timeCallbackFunction)
         : ClockFace_Base(timeCallbackFunction) {}
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return false; }
     void reset() override final{};
+    uint32_t getUpdateInterval(const FrameContext& frame) const override final;
 };
 
 class ClockFace_Gravity : public ClockFace_Base {
 public:
     ClockFace_Gravity(std::function<ClockFaceTimeStruct(void)> timeCallbackFunction);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return false; }
     void reset() override final;
+    uint32_t getUpdateInterval(const FrameContext& frame) const override final;
 
 private:
     canvas::Canvas _c;
@@ -55,9 +57,10 @@ public:
     ClockFace_GravityFill(
         std::function<ClockFaceTimeStruct(void)> timeCallbackFunction,
         std::unique_ptr<GravityFillTemplate> gravFillTemplate);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return false; }
     void reset() override final;
+    uint32_t getUpdateInterval(const FrameContext& frame) const override final;
 
 private:
     canvas::Canvas _c;
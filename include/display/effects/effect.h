@@ -4,6 +4,7 @@
 /* Project Scope */
 #include "display/canvas.h"
 #include "display/display.h"
+#include "frameContext.h"
 
 /* Arduino Core */
 #include <Arduino.h>
@@ -15,7 +16,8 @@
  * @brief Abstract Base Class for classes that implement an Effect (e.g., a pattern, demo, game, etc. that takes place
  * over time)
  *
- * Effects are expected to manage their own state and timing.
+ * Effects are expected to manage their own state and timing. Timing should be taken from the FrameContext passed to
+ * run(), rather than by reading the clock directly.
  * Effects may run for some period of time.
  * When an effect has completed one 'cycle' (the definition of which will vary per effect) it will indicate that it is
  * 'finished'. However, the effect should still continue to run (loop, restart, etc.) even if it is 'finished'. The
@@ -25,11 +27,17 @@
 class DisplayEffect {
 public:
     // Runs the effect. Returns true if the effect is considered finished.
-    virtual canvas::Canvas run() = 0;
+    virtual canvas::Canvas run(const FrameContext& frame) = 0;
     // Indicates if the effect is finished.
     virtual bool finished() const = 0;
     // Resets the effect to it's initial state
     virtual void reset() = 0;
+    // How long the last frame from run() stays correct, see frameRate. Animated effects keep the default.
+    virtual uint32_t getUpdateInterval([[maybe_unused]] const FrameContext& frame) const {
+        return frameRate::continuous;
+    }
+    // Whether run() reads the music sync fields of FrameContext, so a beat should wake a sleeping loop
+    virtual bool usesBeats() const { return false; }
 };
 
 class DisplayEffectDecorator : public DisplayEffect {
@@ -38,9 +46,11 @@ protected:
 
 public:
     DisplayEffectDecorator(std::shared_ptr<DisplayEffect> effect) : effect(effect) {}
-    canvas::Canvas run() { return effect->run(); }
+    canvas::Canvas run(const FrameContext& frame) { return effect->run(frame); }
     bool finished() const { return effect->finished(); }
     void reset() { effect->reset(); }
+    uint32_t getUpdateInterval(const FrameContext& frame) const { return effect->getUpdateInterval(frame); }
+    bool usesBeats() const { return effect->usesBeats(); }
 };
 
 class EffectDecorator_Timeout : public DisplayEffectDecorator {
@@ -48,18 +58,28 @@ public:
     EffectDecorator_Timeout(std::shared_ptr<DisplayEffect> effect, uint32_t timeout)
         : DisplayEffectDecorator(effect),
           timeoutDuration(timeout) {}
-    canvas::Canvas run() { return effect->run(); }
+    canvas::Canvas run(const FrameContext& frame) {
+        // the timeout starts from the first frame after a reset
+        if (resetPending) {
+            lastResetTime = frame.timeMs;
+            resetPending = false;
+        }
+        lastFrameTime = frame.timeMs;
+        return effect->run(frame);
+    }
     bool finished() const {
-        if (millis() - lastResetTime > timeoutDuration) { return true; }
+        if (!resetPending && lastFrameTime - lastResetTime > timeoutDuration) { return true; }
         return effect->finished();
     }
     void reset() {
-        lastResetTime = millis();
+        resetPending = true;
         effect->reset();
     }
 
 private:
     uint32_t lastResetTime = 0;
+    uint32_t lastFrameTime = 0;
+    bool resetPending = true;
     uint32_t timeoutDuration;
 };
 
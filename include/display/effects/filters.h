@@ -4,16 +4,20 @@
 /* Project Scope */
 #include "display/canvas.h"
 #include "flm_pixeltypes.h"
+#include "frameContext.h"
 
 class FilterMethod {
 public:
-    virtual void apply(canvas::Canvas& c) = 0;
+    virtual void apply(canvas::Canvas& c, const FrameContext& frame) = 0;
+    // How long the filter's output stays correct for unchanged input, see frameRate
+    virtual uint32_t getUpdateInterval() const { return frameRate::continuous; }
 };
 
 class HSVTestPattern : public FilterMethod {
 public:
     HSVTestPattern(){};
-    void apply(canvas::Canvas& c) override;
+    void apply(canvas::Canvas& c, const FrameContext& frame) override;
+    uint32_t getUpdateInterval() const override { return frameRate::idle; }
 };
 
 class SolidColour : public FilterMethod {
@@ -21,7 +25,8 @@ public:
     SolidColour(flm::CRGB colour, bool maintainBrightness = true)
         : colour(colour),
           maintainBrightness(maintainBrightness) {}
-    void apply(canvas::Canvas& c) override;
+    void apply(canvas::Canvas& c, const FrameContext& frame) override;
+    uint32_t getUpdateInterval() const override { return frameRate::idle; }
 
 private:
     flm::CRGB colour;
@@ -36,7 +41,9 @@ public:
           width(width),
           direction(direction),
           maintainBrightness(maintainBrightness) {}
-    void apply(canvas::Canvas& c) override;
+    void apply(canvas::Canvas& c, const FrameContext& frame) override;
+    // The hue moves one step every 1000 / speed milliseconds, so faster waves animate at the full frame rate
+    uint32_t getUpdateInterval() const override;
 
 private:
     float speed;
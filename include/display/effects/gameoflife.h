@@ -7,14 +7,15 @@
 #include "display/effects/effect.h"
 #include "display/effects/filters.h"
 #include "display/effects/utilities.h"
+#include "memoryPlacement.h"
 
 /* Libraries */
 #include <etl/circular_buffer.h>
 
 /* C++ Standard Library */
+#include <functional>
 #include <random>
 #include <set>
-#include <vector>
 
 struct GoLRules {
     int width;
@@ -29,18 +30,23 @@ public:
     void tick();
     bool getAlive() const { return alive; }
     uint32_t getLifespan() const { return lifespan; }
-    std::vector<uint32_t>& getData() { return data; }
+    const memory::PlacedVector<uint32_t>& getData() const { return data; }
     GoLRules& getRules() { return rules; }
     uint32_t getSeed() { return seed; }
     std::size_t XYToIndex(int x, int y) const;
 
 private:
-    int neighbourCount(int xPos, int yPos, int width, int height, const std::vector<uint32_t>& data, bool wrap) const;
-    std::size_t hashState(const std::vector<uint32_t>& state) const;
+    using Grid = memory::PlacedVector<uint32_t>;
+
+    int neighbourCount(int xPos, int yPos, int width, int height, const Grid& data, bool wrap) const;
+    std::size_t hashState(const Grid& state) const;
 
     uint32_t seed;
     GoLRules rules;
-    std::vector<uint32_t> data;
+    // The seed simulation ticks through thousands of generations per reset, so both grids stay in internal RAM.
+    // 'next' is only kept between ticks to avoid reallocating it.
+    Grid data{{memory::Placement::hot, "GoL grid"}};
+    Grid next{{memory::Placement::hot, "GoL grid"}};
     bool alive{};
     std::minstd_rand rand;
 
@@ -74,7 +80,7 @@ public:
         uint32_t fadeInterval,
         colourGenerator::Generator colourGenerator,
         bool wrap = true);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final;
 
@@ -95,7 +101,8 @@ private:
     uint32_t _updateInterval;
     uint32_t _fadeInterval;
 
-    std::multiset<GoLScore> bestScores;
+    std::multiset<GoLScore, std::less<GoLScore>, memory::PlacementAllocator<GoLScore>> bestScores{
+        memory::PlacementAllocator<GoLScore>(memory::Placement::bulk, "GoL seed table")};
     uint8_t bestScoresToKeep = 20;
 
     std::minstd_rand rand;
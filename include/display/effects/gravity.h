@@ -10,7 +10,7 @@ public:
     enum class Direction { up, down, left, right };
 
     Gravity(uint32_t moveInterval, bool empty, Gravity::Direction direction);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final;
 
@@ -27,6 +27,7 @@ private:
     bool _finished = false;
     uint32_t _moveInterval;
     uint32_t _lastMoveTime = 0;
+    bool _restartTiming = true;
     bool _empty;
     Direction _direction;
 };
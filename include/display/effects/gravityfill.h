@@ -19,7 +19,7 @@ public:
         uint32_t fillInterval,
         uint32_t moveInterval,
         colourGenerator::Generator colourGenerator);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final {
         randomFill->reset();
@@ -43,7 +43,7 @@ public:
     enum class FillMode { random, leftRightPerCol, leftRightPerRow };
 
     GravityFillTemplate(FillMode fillMode);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final;
     void setTemplate(const canvas::Canvas& c) { templateCanvas = c; }
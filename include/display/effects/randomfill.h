@@ -12,7 +12,7 @@
 class RandomFill : public DisplayEffect {
 public:
     RandomFill(const canvas::Canvas& size, uint32_t fillInterval, colourGenerator::Generator colourGenerator);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final {
         _finished = false;
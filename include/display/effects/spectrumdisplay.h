@@ -8,7 +8,7 @@
 class SpectrumDisplay : public DisplayEffect {
 public:
     SpectrumDisplay(const canvas::Canvas& size);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final;
 
@@ -18,7 +18,7 @@ public:
         uint16_t stepDelay = 100,
         uint16_t timeToHoldAtEnd = 1000,
         uint8_t characterSpacing = 1);
-    virtual canvas::Canvas run() override;
+    virtual canvas::Canvas run(const FrameContext& frame) override;
     virtual bool finished() const override { return _finished; }
     virtual void reset() override {
         _finished = false;
@@ -60,7 +60,7 @@ public:
         uint16_t stepDelay = 100,
         uint16_t timeToHoldAtEnd = 1000,
         uint8_t characterSpacing = 1);
-    canvas::Canvas run() override;
+    canvas::Canvas run(const FrameContext& frame) override;
     bool finished() const override { return cycles >= 2; }
     void reset() override {
         TextScroller::reset();
@@ -16,7 +16,7 @@ struct VolumeDisplayColourMap {
 class VolumeDisplay : public DisplayEffect {
 public:
     VolumeDisplay(const canvas::Canvas& size);
-    canvas::Canvas run() override final;
+    canvas::Canvas run(const FrameContext& frame) override final;
     bool finished() const override final { return _finished; }
     void reset() override final;
 
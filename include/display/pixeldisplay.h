@@ -21,6 +21,7 @@ public:
 
     void setBrightness(uint8_t brightness) override final { this->brightness = brightness; }
     void update(const canvas::Canvas& canvas) override final;
+    void update(const canvas::Canvas& canvas, const FrameContext& frame) override final;
 
     uint8_t getWidth() const override final { return width; }
     uint8_t getHeight() const override final { return height; }
@@ -42,8 +43,9 @@ private:
     uint8_t brightness{255};
 
     // Instrumentation
-    InstrumentationTrace traceUpdateTotal{"Display Update - Overall"};
+    InstrumentationTrace traceUpdateTotal{"Display Update - Overall", InstrumentationTrace::Detail::percentiles};
     InstrumentationTrace traceUpdateLEDWrite{"Display Update - LED Output"};
+    InstrumentationTrace traceAudioLatency{"Audio to LED Latency (us)", InstrumentationTrace::Detail::percentiles};
 };
 
 #endif // pixeldisplay_h
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef transitions_h
+#define transitions_h
+
+/* Project Scope */
+#include "display/canvas.h"
+#include "flm_pixeltypes.h"
+#include "frameContext.h"
+
+/* C++ Standard Library */
+#include <array>
+#include <cstdint>
+
+namespace transitions {
+
+/**
+ * @brief Position within a transition, from 0 (showing only the outgoing canvas) to 255 (showing only the incoming
+ * canvas).
+ */
+using Progress = uint8_t;
+
+enum class Type { slide, crossfade, wipe, dissolve };
+
+const char* typeName(Type type);
+
+/* Easing */
+
+constexpr float easeInOutCubic(float t) {
+    if (t < 0.5f) {
+        return 4 * t * t * t;
+    } else {
+        float f = ((2 * t) - 2);
+        return 0.5f * f * f * f + 1;
+    }
+}
+
+using EasingTable = std::array<Progress, 256>;
+
+// Samples an easing function (mapping 0-1 to 0-1) into a lookup table indexed by linear progress.
+template <typename EasingFunction> constexpr EasingTable makeEasingTable(EasingFunction easing) {
+    EasingTable table{};
+    for (std::size_t i = 0; i < table.size(); i++) {
+        float eased = easing(static_cast<float>(i) / 255);
+        if (eased < 0) { eased = 0; }
+        if (eased > 1) { eased = 1; }
+        table[i] = static_cast<Progress>(eased * 255 + 0.5f);
+    }
+    return table;
+}
+
+inline constexpr EasingTable easeInOutCubicTable = makeEasingTable(easeInOutCubic);
+
+// Converts a 0-1 fraction of the transition duration into an eased Progress value.
+Progress easedProgress(float fraction, const EasingTable& table = easeInOutCubicTable);
+
+/* Composition Kernels
+ *
+ * Each kernel writes the blend of 'from' and 'to' at the given progress into 'out'. 'out' must not alias either input.
+ * Inputs smaller than 'out' are padded with black. Kernels do not allocate.
+ *
+ * 'direction' follows the effect cycling convention: +1 brings the incoming canvas in from the right, -1 from the
+ * left.
+ */
+
+void slide(const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, int direction, canvas::Canvas& out);
+void crossfade(const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, canvas::Canvas& out);
+void wipe(const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, int direction, canvas::Canvas& out);
+void dissolve(const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, canvas::Canvas& out);
+
+void compose(
+    Type type,
+    const canvas::Canvas& from,
+    const canvas::Canvas& to,
+    Progress progress,
+    int direction,
+    canvas::Canvas& out);
+
+/**
+ * @brief Blends from a frozen snapshot of outgoing content to live incoming content over a fixed duration.
+ *
+ * The outgoing source is captured once when the transition starts, so only the incoming source needs to be rendered
+ * while the transition runs. Each frame then costs a single blend into a preallocated output canvas.
+ */
+class Transition {
+public:
+    Transition(const canvas::Canvas& size) : snapshot(size), output(size) {}
+
+    // Start a transition away from 'outgoing', which is copied and held for the duration of the transition.
+    void start(const canvas::Canvas& outgoing, Type type, uint32_t durationMs, int direction = 1);
+    // Blend the snapshot with the latest incoming frame. Once the duration has elapsed the transition ends and the
+    // incoming frame is returned unchanged.
+    const canvas::Canvas& apply(const canvas::Canvas& incoming, const FrameContext& frame);
+    bool active() const { return running; }
+
+private:
+    canvas::Canvas snapshot;
+    canvas::Canvas output;
+    Type type{Type::slide};
+    uint32_t durationMs{0};
+    uint32_t elapsedMs{0};
+    int direction{1};
+    bool running{false};
+};
+
+} // namespace transitions
+
+#endif // transitions_h
@@ -0,0 +1,40 @@
+#ifndef fixedpoint_h
+#define fixedpoint_h
+
+/* C++ Standard Library */
+#include <cmath>
+#include <cstdint>
+
+/* Helpers for Q15 fixed-point arithmetic (values in [-1, 1) stored as int16_t scaled by 2^15) */
+namespace fixed {
+
+inline int16_t toQ15(double value) {
+    long scaled = std::lround(value * 32767);
+    if (scaled > 32767) { return 32767; }
+    if (scaled < -32768) { return -32768; }
+    return static_cast<int16_t>(scaled);
+}
+
+// |v|, saturating -32768 to 32767
+inline int16_t absQ15(int16_t v) { return v == INT16_MIN ? INT16_MAX : static_cast<int16_t>(v < 0 ? -v : v); }
+
+// floor(sqrt(value)), bit by bit without floating point
+inline uint32_t isqrt(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = uint64_t(1) << 62;
+    while (bit > value) { bit >>= 2; }
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+} // namespace fixed
+
+#endif // fixedpoint_h
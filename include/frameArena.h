@@ -0,0 +1,109 @@
+#ifndef framearena_h
+#define framearena_h
+
+/* Project Scope */
+#include "instrumentation.h"
+
+/* C++ Standard Library */
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Bump allocator for short-lived scratch memory used while rendering a single frame.
+ *
+ * Allocations are carved sequentially out of one preallocated buffer and are never freed individually. The whole
+ * arena is reset once per frame (by LoopTimeManager::idle), at which point every allocation made from it during the
+ * frame becomes invalid. If the arena runs out of space, allocators fall back to the heap.
+ *
+ * The arena is not thread-safe and should only be used from the render loop.
+ */
+class FrameArena : public Instrumented {
+public:
+    explicit FrameArena(std::size_t capacity);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    void operator=(const FrameArena&) = delete;
+
+    // Returns nullptr if the request does not fit in the remaining space.
+    void* allocate(std::size_t bytes, std::size_t alignment);
+    bool owns(const void* ptr) const { return ptr >= buffer && ptr < buffer + capacity; }
+    // Release everything allocated this frame and record how much was used.
+    void reset();
+
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getUsed() const { return used; }
+    std::size_t getHighWaterMark() const { return highWaterMark; }
+
+    // Instrumentation
+    std::vector<InstrumentationTrace*> getInstrumentation() override final { return {&traceBytesUsed}; }
+
+private:
+    uint8_t* buffer;
+    const std::size_t capacity;
+    std::size_t used{0};
+    std::size_t highWaterMark{0};
+
+    // Instrumentation
+    InstrumentationTrace traceBytesUsed{"Frame Arena - Used (bytes)"};
+};
+
+class FrameArenaSingleton {
+public:
+    static FrameArena& get();
+    FrameArenaSingleton(const FrameArenaSingleton&) = delete;
+    void operator=(const FrameArenaSingleton&) = delete;
+};
+
+/**
+ * @brief Standard library allocator that draws from a FrameArena, or from the heap if constructed without one.
+ *
+ * Copies of a container never inherit the arena (copy construction selects the heap, and assignment keeps the
+ * destination's allocator). Move construction does: std::vector always takes the allocator along with the data. So an
+ * arena-backed container must stay local to the frame that created it; never return it, move-construct from it or
+ * store it anywhere that lives past LoopTimeManager::idle(), which recycles the arena.
+ */
+template <typename T> class FrameAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    FrameAllocator() = default;
+    explicit FrameAllocator(FrameArena& arena) : arena(&arena) {}
+    template <typename U> FrameAllocator(const FrameAllocator<U>& other) : arena(other.getArena()) {}
+
+    T* allocate(std::size_t n) {
+        if (arena) {
+            if (void* p = arena->allocate(n * sizeof(T), alignof(T))) { return static_cast<T*>(p); }
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        // arena memory is released all at once when the arena is reset
+        if (arena && arena->owns(p)) { return; }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    FrameAllocator select_on_container_copy_construction() const { return FrameAllocator(); }
+
+    FrameArena* getArena() const { return arena; }
+
+private:
+    FrameArena* arena = nullptr;
+};
+
+template <typename T, typename U> bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) {
+    return a.getArena() == b.getArena();
+}
+template <typename T, typename U> bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) {
+    return !(a == b);
+}
+
+template <typename T> using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif // framearena_h
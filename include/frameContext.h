@@ -0,0 +1,73 @@
+#ifndef framecontext_h
+#define framecontext_h
+
+/* C++ Standard Library */
+#include <cstdint>
+
+/**
+ * @brief Timing information for a single rendered frame.
+ *
+ * One FrameContext is created per loop and passed down through the modes and effects, so that everything drawn in a
+ * frame shares a single timebase instead of each effect polling millis() on its own.
+ */
+struct FrameContext {
+    uint32_t timeMs{};      // Time at the start of this frame (milliseconds)
+    uint32_t deltaMs{};     // Time elapsed since the previous frame (milliseconds)
+    uint32_t frameNumber{}; // Number of frames produced before this one
+
+    // Music sync, filled in from the audio beat tracker (all zero without audio)
+    uint8_t beats{};       // Beats since the previous frame
+    uint8_t onsets{};      // Onsets (drum hits, note attacks...) since the previous frame
+    float onsetStrength{}; // Strength of the strongest of those onsets, above 1
+    float bpm{};           // Tempo estimate, 0 if unknown
+    float beatPhase{};     // Position within the current beat [0, 1), 0 at each beat
+
+    uint32_t audioCaptureUs{}; // micros() when this frame's newly analysed audio arrived, 0 if none is new
+
+    float deltaSeconds() const { return static_cast<float>(deltaMs) / 1000; }
+};
+
+/**
+ * How long what is on screen can stand before it needs redrawing, in milliseconds.
+ *
+ * Effects, filters and modes report this from getUpdateInterval(), and the loop sleeps through frames that would not
+ * change anything. Combine intervals with std::min.
+ */
+namespace frameRate {
+
+constexpr uint32_t continuous = 0;    // Animating: redraw at the full frame rate
+constexpr uint32_t idle = UINT32_MAX; // Static until something external changes it
+
+constexpr uint32_t fullRatePeriod = 15; // The loop's frame period while animating
+
+// For content that changes when the minute does, given the current second. Errs towards waking a little late rather
+// than repeatedly early, as seconds have no finer resolution.
+constexpr uint32_t untilNextMinute(uint8_t second) { return second < 59 ? (59 - second) * 1000u : 1000u; }
+
+} // namespace frameRate
+
+/**
+ * @brief Produces a FrameContext for each frame from a supplied clock value.
+ *
+ * The clock value is passed in rather than read here, so that effects can be stepped at arbitrary speeds (e.g., in
+ * benchmarks or tests) by ticking with synthetic times.
+ */
+class FrameClock {
+public:
+    FrameContext tick(uint32_t nowMs) {
+        FrameContext frame{};
+        frame.timeMs = nowMs;
+        frame.deltaMs = started ? nowMs - lastTimeMs : 0;
+        frame.frameNumber = frameCount++;
+        lastTimeMs = nowMs;
+        started = true;
+        return frame;
+    }
+
+private:
+    uint32_t lastTimeMs{0};
+    uint32_t frameCount{0};
+    bool started{false};
+};
+
+#endif // framecontext_h
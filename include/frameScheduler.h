@@ -0,0 +1,98 @@
+#ifndef framescheduler_h
+#define framescheduler_h
+
+/* Project Scope */
+#include "instrumentation.h"
+
+/* C++ Standard Library */
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#ifdef PIXELCLOCK_DESKTOP
+#include <condition_variable>
+#include <mutex>
+#endif
+
+/**
+ * @brief Runs frames at a fixed rate, sleeping between them instead of spinning.
+ *
+ * Frame deadlines lie on a fixed grid of 'periodUs', so timing error does not accumulate from frame to frame. When a
+ * frame overruns its slot, the policy decides what happens to the deadlines that have already passed:
+ *  - catchUp runs the late frames back to back, up to maxCatchUp of them, to recover the lost time (steady animation
+ *    speed for effects that step once per frame)
+ *  - skip drops them and carries on from the next deadline on the grid (lowest load when the frame rate is too high)
+ *
+ * The caller may also say how long nothing needs redrawing (see frameRate in frameContext.h). The next frame then moves
+ * to the first deadline on the grid after that time, so a static clock face costs a frame a second rather than a
+ * frame every period. wake() cuts the sleep short for events. For input it can also keep the full frame rate for
+ * holdUs afterwards, so button handling (debounce, double clicks) still sees regular updates.
+ *
+ * On ESP32 the wait is a one-shot esp_timer that notifies the waiting task, so the core really sleeps and the deadline
+ * has microsecond resolution rather than the one-tick resolution of vTaskDelayUntil. On desktop it is sleep_until().
+ */
+class FrameScheduler : public Instrumented {
+public:
+    enum class OverrunPolicy : uint8_t { catchUp, skip };
+
+    explicit FrameScheduler(uint32_t periodUs, OverrunPolicy policy = OverrunPolicy::skip, uint8_t maxCatchUp = 2);
+    ~FrameScheduler();
+    FrameScheduler(const FrameScheduler&) = delete;
+    void operator=(const FrameScheduler&) = delete;
+
+    static constexpr uint32_t holdUs = 1000000;
+
+    // Sleeps until the next frame is due, or until wake(). Call once per frame, when the previous one is complete.
+    // 'idleUs' is how long after the previous frame's start the next one can wait, 0 to run at the full rate.
+    void waitForNextFrame(uint32_t idleUs = 0);
+
+    // Works out when the frame that may start at 'nowUs' is due, and does the overrun accounting. Returns that time,
+    // which is 'nowUs' if the frame is already late. waitForNextFrame() is this followed by a sleep.
+    uint32_t schedule(uint32_t nowUs, uint32_t idleUs = 0);
+
+    // Ends the current sleep early, or the next one if the caller is not sleeping. With 'hold', the full frame rate is
+    // then kept for holdUs. Safe from any task; use wakeFromISR() in interrupt handlers.
+    void wake(bool hold = false);
+    void wakeFromISR(bool hold = false);
+
+    uint32_t getPeriodUs() const { return periodUs; }
+    // Takes effect from the next deadline
+    void setPeriodUs(uint32_t period) { periodUs = period; }
+
+    // Counts since construction
+    uint32_t getOverruns() const { return overruns; }     // Frames that started after their deadline
+    uint32_t getSkippedFrames() const { return skipped; } // Deadlines dropped without running a frame
+
+    // Instrumentation
+    std::vector<InstrumentationTrace*> getInstrumentation() override final { return {&traceLateness, &traceSleep}; }
+
+private:
+    void sleepUntil(uint32_t deadlineUs);
+
+    uint32_t periodUs;
+    const OverrunPolicy policy;
+    const uint8_t maxCatchUp;
+
+    uint32_t nextDeadlineUs = 0;
+    uint32_t lastStartUs = 0;
+    uint32_t holdUntilUs = 0;
+    bool started = false;
+    bool holding = false;
+    std::atomic<bool> wakeRequested{false};
+    std::atomic<bool> holdRequested{false};
+    uint32_t overruns = 0;
+    uint32_t skipped = 0;
+
+#ifdef PIXELCLOCK_DESKTOP
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+#else
+    void* wakeTimer = nullptr; // esp_timer_handle_t
+    std::atomic<void*> waitingTask{nullptr};
+#endif
+
+    // Instrumentation
+    InstrumentationTrace traceLateness{"Frame Scheduler - Late (us)", InstrumentationTrace::Detail::percentiles};
+    InstrumentationTrace traceSleep{"Frame Scheduler - Sleep (us)"};
+};
+
+#endif // framescheduler_h
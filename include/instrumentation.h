@@ -2,33 +2,71 @@
 #define instrumentation_h
 
 /* C++ Standard Library */
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+/**
+ * @brief Histogram of uint32_t values in logarithmic buckets, for percentiles at a fixed memory cost.
+ *
+ * Values below 8 get a bucket each, and every power of two above that is split into 8 buckets, so a percentile is
+ * within about 6% of the true value over the whole range.
+ */
+class LogHistogram {
+public:
+    static constexpr uint8_t subBucketBits = 3;
+    static constexpr std::size_t subBuckets = 1u << subBucketBits;
+    static constexpr std::size_t bucketCount = subBuckets + (32 - subBucketBits) * subBuckets;
+
+    void add(uint32_t value) { counts[bucketOf(value)]++; }
+    void reset() { counts.fill(0); }
+
+    // Value at or below which 'fraction' (0 to 1) of the added values lie, or 0 if empty
+    uint32_t percentile(float fraction) const;
+
+    static std::size_t bucketOf(uint32_t value);
+    // Midpoint of the range of values in 'bucket'
+    static uint32_t bucketValue(std::size_t bucket);
+
+private:
+    std::array<uint32_t, bucketCount> counts{};
+};
+
 class InstrumentationTrace {
 public:
-    InstrumentationTrace(std::string name);
+    enum class Detail : uint8_t {
+        summary,     // hits, min, max and average
+        percentiles, // also a histogram for percentiles (about 1 kB more)
+    };
+
+    InstrumentationTrace(std::string name, Detail detail = Detail::summary);
     void start();
     void stop();
     void update(uint32_t value);
     uint32_t getMin() const { return min; }
     uint32_t getMax() const { return max; }
-    uint32_t getAvg() const { return avg; }
+    uint32_t getAvg() const { return hits ? static_cast<uint32_t>(sum / hits) : 0; }
     uint32_t getHits() const { return hits; }
     const std::string& getName() const { return name; }
     void reset();
 
+    bool hasPercentiles() const { return histogram != nullptr; }
+    // Value at or below which 'fraction' (0 to 1) of the values since the last reset lie, clamped to the min and
+    // max. 0 without percentiles or values.
+    uint32_t getPercentile(float fraction) const;
+
 private:
     std::string name;
     uint32_t started{};
-    uint32_t avg{};
     uint64_t sum{};
-    uint32_t sumSamples{};
     uint32_t hits{};
     uint32_t min{};
     uint32_t max{};
     bool empty{true};
+    std::unique_ptr<LogHistogram> histogram;
 };
 
 class Instrumented {
@@ -2,7 +2,10 @@
 #define looptimemanager_h
 
 /* Project Scope */
+#include "frameContext.h"
+#include "frameScheduler.h"
 #include "instrumentation.h"
+#include "tasks.h"
 
 /* C++ Standard Library */
 #include <cstdint>
@@ -11,21 +14,47 @@
 
 class LoopTimeManager {
 public:
-    LoopTimeManager(uint32_t desiredLoopDuration, uint32_t statReportInterval);
-    void idle();
+    // Frames are scheduled every 'desiredLoopDuration' milliseconds
+    LoopTimeManager(
+        uint32_t desiredLoopDuration,
+        uint32_t statReportInterval,
+        FrameScheduler::OverrunPolicy overrunPolicy = FrameScheduler::OverrunPolicy::skip);
+
+    // Call at the end of each frame: releases per-frame resources, prints the periodic report, and sleeps until the
+    // next frame is due. 'updateInterval' is how long the frame just drawn stays correct (see frameRate), letting the
+    // loop sleep for longer, up to maxIdleInterval.
+    void idle(uint32_t updateInterval = frameRate::continuous);
+
+    // Ends the sleep in idle() early, for events that need a prompt frame. wakeOnInputFromISR() also keeps the full
+    // frame rate for a moment, while the input is handled.
+    void wake() { scheduler.wake(); }
+    void wakeOnInputFromISR();
+
+    // Longest the loop sleeps however static the display, so polled inputs and sensors keep updating (milliseconds)
+    static constexpr uint32_t maxIdleInterval = 1000;
 
     void registerTraceCallback(std::function<std::vector<InstrumentationTrace*>()> callback) {
         callbacks.push_back(callback);
     }
 
 private:
-    const uint32_t desiredLoopDuration;
-    uint32_t lastLoopTime = 0;
+    // Text report, every statReportInterval
+    void printReport();
+    // Binary telemetry sample, every telemetryInterval (see telemetry.h)
+    void publishTelemetry();
+
+    static constexpr uint32_t telemetryInterval = 100;      // milliseconds
+    static constexpr uint32_t telemetryDetailInterval = 50; // samples between trace names and the slower reports
+
+    FrameScheduler scheduler;
     const uint32_t statReportInterval;
     uint32_t lastStatReportTime = 0;
+    uint32_t lastTelemetryTime = 0;
+    uint32_t telemetrySequence = 0;
 
-    InstrumentationTrace loop{"Overall Loop"};
+    InstrumentationTrace loop{"Overall Loop", InstrumentationTrace::Detail::percentiles};
     InstrumentationTrace printout{"Instrumentation Printout"};
+    tasks::TaskStats& renderTask = tasks::TaskMonitorSingleton::get().add(tasks::config::render);
 
     std::vector<std::function<std::vector<InstrumentationTrace*>()>> callbacks;
 };
@@ -0,0 +1,90 @@
+#ifndef memoryplacement_h
+#define memoryplacement_h
+
+/* C++ Standard Library */
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Placement policy for long-lived buffers.
+ *
+ * Internal SRAM is fast and DMA-capable, but it is also what the Bluetooth stack, task stacks and DMA descriptors
+ * need, while PSRAM is plentiful but slower. Buffers state which they belong in, and are recorded by name so the
+ * placement report shows where each one actually landed (an allocation falls back to the other region when its
+ * preferred one is full or absent, as PSRAM is on desktop).
+ */
+namespace memory {
+
+enum class Placement : uint8_t {
+    hot,  // Internal SRAM: touched in tight loops, or used for DMA
+    bulk, // PSRAM when fitted: large, and accessed sequentially or rarely
+};
+
+enum class Region : uint8_t { internal, psram };
+
+const char* placementName(Placement placement);
+const char* regionName(Region region);
+
+// Allocates 'bytes' for the buffer called 'name', which must be a string literal. Returns nullptr if neither region
+// has room. Free with release().
+void* allocate(std::size_t bytes, Placement placement, const char* name);
+// As allocate(), but throws std::bad_alloc (or aborts, without exceptions) instead of returning nullptr
+void* allocateOrFail(std::size_t bytes, Placement placement, const char* name);
+void release(void* ptr);
+
+struct PlacementRecord {
+    const char* name;
+    Placement placement; // Requested
+    Region region;       // Where the most recent allocation landed
+    uint32_t liveBytes;
+    uint32_t liveCount;
+    uint32_t fallbacks; // Allocations that did not land in the requested region
+};
+
+// One record per buffer name allocated so far
+std::vector<PlacementRecord> getPlacementReport();
+void printPlacementReport();
+
+// Standard library allocator placing a container's storage according to a placement policy. Allocators are equal when
+// they place and name storage alike; moves and swaps take the allocator along, so storage keeps the record it was
+// allocated under.
+template <typename T> class PlacementAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PlacementAllocator(Placement placement, const char* name) : placement(placement), name(name) {}
+    template <typename U>
+    PlacementAllocator(const PlacementAllocator<U>& other) : placement(other.getPlacement()), name(other.getName()) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(memory::allocateOrFail(n * sizeof(T), placement, name));
+    }
+    void deallocate(T* p, std::size_t) { release(p); }
+
+    Placement getPlacement() const { return placement; }
+    const char* getName() const { return name; }
+
+    template <typename U> bool operator==(const PlacementAllocator<U>& other) const {
+        // the same name can be a different pointer in another translation unit, as the records allow
+        const bool sameName = name == other.getName() || std::strcmp(name, other.getName()) == 0;
+        return placement == other.getPlacement() && sameName;
+    }
+    template <typename U> bool operator!=(const PlacementAllocator<U>& other) const { return !(*this == other); }
+
+private:
+    Placement placement;
+    const char* name;
+};
+
+template <typename T> using PlacedVector = std::vector<T, PlacementAllocator<T>>;
+
+} // namespace memory
+
+#endif // memoryplacement_h
@@ -4,6 +4,7 @@
 /* Project Scope */
 #include "display/effects/effect.h"
 #include "display/effects/filters.h"
+#include "display/transitions.h"
 #include "modes/modes.h"
 
 /* C++ Standard Library */
@@ -14,11 +15,19 @@
 
 class Mode_ClockFace : public MainModeFunction {
 public:
-    Mode_ClockFace(ButtonReferences buttons);
+    Mode_ClockFace(const canvas::Canvas& size, ButtonReferences buttons);
+    // With the given faces and filters, rotated through in order, instead of the default set
+    Mode_ClockFace(
+        const canvas::Canvas& size,
+        ButtonReferences buttons,
+        std::vector<std::unique_ptr<DisplayEffect>> faces,
+        std::vector<std::unique_ptr<FilterMethod>> filters);
+    uint32_t getUpdateInterval(const FrameContext& frame) const override final;
+    bool usesBeats() const override final { return faces[clockfaceIndex]->usesBeats(); }
 
 protected:
     void moveIntoCore() override final;
-    canvas::Canvas runCore() override final;
+    canvas::Canvas runCore(const FrameContext& frame) override final;
     void moveOutCore() override final {}
 
 private:
@@ -30,6 +39,7 @@ private:
     uint32_t filterChangePeriod = 10000;
     ClockFaceTimeStruct timePrev;
     std::minstd_rand rand;
+    transitions::Transition faceTransition;
 };
 
 #endif // modes_clockface_h
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 /* Project Scope */
 #include "display/effects/effect.h"
+#include "display/transitions.h"
 #include "modes/modes.h"
 
 /* C++ Standard Library */
@@ -17,27 +18,21 @@ struct EffectId {
 class Mode_Effects : public MainModeFunction {
 public:
     Mode_Effects(const canvas::Canvas& size, ButtonReferences buttons);
+    bool usesBeats() const override final { return effects[effectIndex].ptr->usesBeats(); }
 
 protected:
     void moveIntoCore() override final;
-    canvas::Canvas runCore() override final;
+    canvas::Canvas runCore(const FrameContext& frame) override final;
     void moveOutCore() override final {}
 
 private:
     std::vector<EffectId> effects;
     std::size_t effectIndex = 0;
 
+    // direction of a requested move to the next effect, applied on the next run
     int transitionDir = 0;
-    float transitionPercentage = 0.0;
-
-    enum class State {
-        Stable,
-        Transition,
-    };
-
-    uint32_t lastLoopTime = 0;
-
-    State currentState = State::Stable;
+    transitions::Type transitionType = transitions::Type::slide;
+    transitions::Transition transition;
 };
 
 #endif // modes_effects_h
\ No newline at end of file
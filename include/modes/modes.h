@@ -7,6 +7,8 @@
 #include "display/effects/effect.h"
 #include "display/effects/filters.h"
 #include "display/effects/textscroller.h"
+#include "display/transitions.h"
+#include "frameContext.h"
 #include "instrumentation.h"
 #include "timekeeping.h"
 
@@ -31,18 +33,24 @@ public:
     // should be called by the parent when moving into this mode
     void moveInto();
     // should be called by the parent when this mode is active
-    canvas::Canvas run();
+    canvas::Canvas run(const FrameContext& frame);
     // should be called by the parent when moving out of this mode
     void moveOut();
     // indicates that this mode is ready to exit/return
     virtual bool finished() const { return _finished; }
     // get the name of this mode
     std::string getName() const { return _name; }
+    // how long the last frame from run() stays correct, see frameRate
+    virtual uint32_t getUpdateInterval([[maybe_unused]] const FrameContext& frame) const {
+        return frameRate::continuous;
+    }
+    // whether what run() draws follows the beat, see DisplayEffect::usesBeats()
+    virtual bool usesBeats() const { return false; }
 
 protected:
     virtual void moveIntoCore();
     virtual void moveOutCore() = 0;
-    virtual canvas::Canvas runCore() = 0;
+    virtual canvas::Canvas runCore(const FrameContext& frame) = 0;
     bool _finished = false;
     ButtonReferences buttons;
     std::string _name;
@@ -55,7 +63,11 @@ class ModeManager : public Instrumented {
 public:
     ModeManager(const canvas::Canvas& size, ButtonReferences buttons);
     void cycleMode();
-    canvas::Canvas run();
+    canvas::Canvas run(const FrameContext& frame);
+    // How long the last frame from run() stays correct, see frameRate
+    uint32_t getUpdateInterval(const FrameContext& frame) const;
+    // Whether the active mode follows the beat, so beat events should wake the loop
+    bool usesBeats() const;
 
     // Instrumentation
     std::vector<InstrumentationTrace*> getInstrumentation() override final { return {&traceRunTotal}; }
@@ -63,9 +75,10 @@ public:
 private:
     std::vector<std::unique_ptr<MainModeFunction>> modes;
     uint8_t modeIndex = 0;
+    transitions::Transition transition;
 
     // Instrumentation
-    InstrumentationTrace traceRunTotal{"Mode Run - Overall"};
+    InstrumentationTrace traceRunTotal{"Mode Run - Overall", InstrumentationTrace::Detail::percentiles};
 };
 
 #endif // modes_modes_h
\ No newline at end of file
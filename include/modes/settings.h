@@ -19,7 +19,7 @@ public:
 
 protected:
     void moveIntoCore() override final;
-    canvas::Canvas runCore() override final;
+    canvas::Canvas runCore(const FrameContext& frame) override final;
     void moveOutCore() override final;
 
 private:
@@ -38,7 +38,7 @@ public:
 
 protected:
     void moveIntoCore() override final;
-    canvas::Canvas runCore() override final;
+    canvas::Canvas runCore(const FrameContext& frame) override final;
     void moveOutCore() override final {}
 
 private:
@@ -55,7 +55,7 @@ public:
 
 protected:
     void moveIntoCore() override final {}
-    canvas::Canvas runCore() override final { return canvas::Canvas(); }
+    canvas::Canvas runCore([[maybe_unused]] const FrameContext& frame) override final { return canvas::Canvas(); }
     void moveOutCore() override final {}
 };
 
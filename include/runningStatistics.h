@@ -0,0 +1,92 @@
+#ifndef runningStatistics_h
+#define runningStatistics_h
+
+/* C++ Standard Library */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace utility {
+
+/* Sum and mean of the last N values pushed, updated in O(1) per push */
+template <typename T, std::size_t N> class RunningSum {
+public:
+    void push(T value) {
+        if (count == N) { sum -= values[next]; }
+        values[next] = value;
+        sum += value;
+        next = (next + 1) % N;
+        if (count < N) { count++; }
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T getSum() const { return static_cast<T>(sum); }
+    // 0 when empty
+    T getMean() const { return count == 0 ? T{} : static_cast<T>(sum / count); }
+
+private:
+    std::array<T, N> values{};
+    std::size_t next = 0;
+    std::size_t count = 0;
+    // accumulate in double so adding and removing values does not drift over a long run
+    double sum = 0;
+};
+
+/*
+ * Minimum and maximum of the last N values pushed, each in amortised O(1) per push.
+ *
+ * Each extreme is tracked with a monotonic deque of candidates: a new value evicts every older candidate it beats
+ * (they can never be the extreme again while it is in the window), and candidates leave the front once they fall out
+ * of the window. The front is therefore always the extreme of the window.
+ */
+template <typename T, std::size_t N> class RunningMinMax {
+public:
+    void push(T value) {
+        const uint32_t index = pushed++;
+        minimum.push(index, value, [](T a, T b) { return a <= b; });
+        maximum.push(index, value, [](T a, T b) { return a >= b; });
+    }
+
+    bool empty() const { return pushed == 0; }
+    // Only meaningful when not empty
+    T getMin() const { return minimum.front(); }
+    T getMax() const { return maximum.front(); }
+
+private:
+    class MonotonicDeque {
+    public:
+        // Drops candidates from the back while 'beats(value, candidate)', then adds 'value'
+        template <typename Compare> void push(uint32_t index, T value, Compare beats) {
+            // expire first, so the window never holds more than N entries
+            if (length > 0 && index - at(0).index >= N) {
+                head = (head + 1) % N;
+                length--;
+            }
+            while (length > 0 && beats(value, at(length - 1).value)) { length--; }
+            at(length++) = {index, value};
+        }
+
+        T front() const { return entries[head].value; }
+
+    private:
+        struct Entry {
+            uint32_t index;
+            T value;
+        };
+
+        Entry& at(std::size_t i) { return entries[(head + i) % N]; }
+
+        std::array<Entry, N> entries{};
+        std::size_t head = 0;
+        std::size_t length = 0;
+    };
+
+    MonotonicDeque minimum;
+    MonotonicDeque maximum;
+    uint32_t pushed = 0;
+};
+
+} // namespace utility
+
+#endif // runningStatistics_h
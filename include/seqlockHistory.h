@@ -0,0 +1,105 @@
+#ifndef seqlockhistory_h
+#define seqlockhistory_h
+
+/* C++ Standard Library */
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Fixed-size history of the most recent N values, published by one writer and read by any number of readers
+ * without locks.
+ *
+ * Each slot is guarded by its own sequence counter (a seqlock): the writer makes the counter odd, writes the value,
+ * then makes it even again. A reader copies the value out and retries if the counter was odd or changed while it was
+ * copying, so it never returns a torn value. Publishing is wait-free and never waits on readers.
+ *
+ * Values are stored as relaxed atomic words so concurrent reads and writes of a slot are well defined; T must be
+ * trivially copyable.
+ */
+template <typename T, std::size_t N> class SeqlockHistory {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockHistory copies values word by word");
+    static_assert(N > 0, "SeqlockHistory needs at least one slot");
+
+public:
+    SeqlockHistory() = default;
+    SeqlockHistory(const SeqlockHistory&) = delete;
+    void operator=(const SeqlockHistory&) = delete;
+
+    /* Writer */
+
+    void publish(const T& value) {
+        const uint32_t n = published.load(std::memory_order_relaxed);
+        Slot& slot = slots[n % N];
+
+        const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint32_t words[wordCount]{};
+        std::memcpy(words, &value, sizeof(T));
+        for (std::size_t i = 0; i < wordCount; i++) { slot.words[i].store(words[i], std::memory_order_relaxed); }
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        published.store(n + 1, std::memory_order_release);
+    }
+
+    /* Readers */
+
+    // Number of values currently held (up to N)
+    std::size_t size() const {
+        const uint32_t n = published.load(std::memory_order_acquire);
+        return n < N ? n : N;
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr std::size_t capacity() { return N; }
+
+    // Total number of values ever published. Readers can compare this between frames to see how many are new.
+    uint32_t getPublishedCount() const { return published.load(std::memory_order_acquire); }
+
+    // Copy out the value published 'age' values ago (0 is the latest). Returns false if there is no such value.
+    bool read(std::size_t age, T& out) const {
+        while (true) {
+            const uint32_t n = published.load(std::memory_order_acquire);
+            if (age >= n || age >= N) { return false; }
+            const Slot& slot = slots[(n - 1 - age) % N];
+
+            const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) { continue; }
+
+            uint32_t words[wordCount];
+            for (std::size_t i = 0; i < wordCount; i++) { words[i] = slot.words[i].load(std::memory_order_relaxed); }
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            const uint32_t after = slot.sequence.load(std::memory_order_relaxed);
+            // also retry if the writer moved on, as the slot may no longer hold the value at this age
+            if (before == after && published.load(std::memory_order_relaxed) == n) {
+                std::memcpy(&out, words, sizeof(T));
+                return true;
+            }
+        }
+    }
+
+    // Convenience for the latest value, or a default-constructed T if nothing has been published yet
+    T latest() const {
+        T value{};
+        read(0, value);
+        return value;
+    }
+
+private:
+    static constexpr std::size_t wordCount = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};
+        std::array<std::atomic<uint32_t>, wordCount> words{};
+    };
+
+    std::array<Slot, N> slots{};
+    std::atomic<uint32_t> published{0};
+};
+
+#endif // seqlockhistory_h
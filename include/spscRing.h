@@ -0,0 +1,115 @@
+#ifndef spscring_h
+#define spscring_h
+
+/* Libraries */
+#include <etl/span.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Lock-free ring buffer for handing data from exactly one producer thread to exactly one consumer thread.
+ *
+ * The producer only ever advances the head index and the consumer only ever advances the tail index. Each side
+ * publishes its index with release ordering after copying data, and reads the other side's index with acquire
+ * ordering before copying, so the consumer never sees a slot before the data in it is written and the producer never
+ * overwrites a slot before the data in it has been read. Reads and writes copy in at most two contiguous chunks.
+ *
+ * The consumer can also look at data in place with peek() and release it later with skip(), e.g., to analyse
+ * overlapping windows without copying them out.
+ *
+ * Storage is supplied by the caller (so it can be placed in PSRAM), and its capacity must be a power of two. When
+ * the ring is full, write() stores as much as fits and reports how much that was; existing data is never overwritten.
+ */
+template <typename T> class SpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "SpscRing copies elements with std::copy_n");
+
+public:
+    SpscRing(T* storage, std::size_t capacity) : storage(storage), capacity(capacity), mask(capacity - 1) {
+        assert(capacity != 0 && (capacity & (capacity - 1)) == 0);
+    }
+    SpscRing(const SpscRing&) = delete;
+    void operator=(const SpscRing&) = delete;
+
+    /* Producer */
+
+    // Number of elements that can currently be written
+    std::size_t free() const {
+        return capacity - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+    }
+
+    // Returns the number of elements written, which is less than data.size() if the ring fills up
+    std::size_t write(etl::span<const T> data) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        const std::size_t t = tail.load(std::memory_order_acquire);
+        const std::size_t n = std::min(data.size(), capacity - (h - t));
+
+        const std::size_t start = h & mask;
+        const std::size_t firstChunk = std::min(n, capacity - start);
+        std::copy_n(data.data(), firstChunk, storage + start);
+        std::copy_n(data.data() + firstChunk, n - firstChunk, storage);
+
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    /* Consumer */
+
+    // Number of elements that can currently be read
+    std::size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+
+    // Returns the number of elements read, which is less than out.size() if the ring runs empty
+    std::size_t read(etl::span<T> out) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        const std::size_t h = head.load(std::memory_order_acquire);
+        const std::size_t n = std::min(out.size(), h - t);
+
+        const std::size_t start = t & mask;
+        const std::size_t firstChunk = std::min(n, capacity - start);
+        std::copy_n(storage + start, firstChunk, out.data());
+        std::copy_n(storage, n - firstChunk, out.data() + firstChunk);
+
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // The oldest readable elements, in up to two contiguous regions (second is empty unless the data wraps around)
+    struct Regions {
+        etl::span<const T> first;
+        etl::span<const T> second;
+    };
+
+    // View the oldest 'count' elements in place, without consuming them. 'count' must not exceed size(). The view
+    // stays valid until those elements are released with skip() or read().
+    Regions peek(std::size_t count) const {
+        assert(count <= size());
+        const std::size_t start = tail.load(std::memory_order_relaxed) & mask;
+        const std::size_t firstChunk = std::min(count, capacity - start);
+        return {{storage + start, firstChunk}, {storage, count - firstChunk}};
+    }
+
+    // Release the oldest 'count' elements (at most size()) back to the producer
+    void skip(std::size_t count) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        const std::size_t n = std::min(count, head.load(std::memory_order_acquire) - t);
+        tail.store(t + n, std::memory_order_release);
+    }
+
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    T* const storage;
+    const std::size_t capacity;
+    const std::size_t mask;
+
+    // Free-running counts of elements written and read. Unsigned wrap-around keeps (head - tail) correct.
+    std::atomic<std::size_t> head{0};
+    std::atomic<std::size_t> tail{0};
+};
+
+#endif // spscring_h
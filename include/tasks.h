@@ -0,0 +1,125 @@
+#ifndef tasks_h
+#define tasks_h
+
+/* C++ Standard Library */
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Task configuration and monitoring.
+ *
+ * Every task's core, priority and stack size are set in one place, tasks::config, so cores can be balanced and stacks
+ * sized without hunting through the code that creates them. The TaskMonitor reports, per task, the smallest amount of
+ * stack that has ever been left free, the share of the report interval spent working, and how many notifications
+ * arrived while the task was still busy with an earlier one (FreeRTOS task notifications coalesce, so those are
+ * missed wake-ups).
+ */
+namespace tasks {
+
+constexpr int8_t anyCore = -1;
+
+struct TaskConfig {
+    const char* name;
+    uint32_t stackBytes; // ESP-IDF sizes stacks in bytes, not words
+    uint8_t priority;
+    int8_t core; // or anyCore
+};
+
+namespace config {
+
+// Analysis of captured audio. Shares core 0 with the Bluetooth stack, above it in priority so analysis keeps up.
+constexpr TaskConfig audio{"AudioUpdate", 2048, 10, 0};
+// The Arduino loop task, which renders. Created by the Arduino core, so this describes it rather than configures it.
+constexpr TaskConfig render{"loopTask", 8192, 1, 1};
+// Sends queued telemetry frames to the serial port. Lowest priority, so it only uses time the other tasks leave.
+constexpr TaskConfig telemetry{"Telemetry", 3072, 1, 0};
+
+} // namespace config
+
+/**
+ * @brief Runtime statistics of one task, updated by the task itself and read by the report.
+ */
+class TaskStats {
+public:
+    const TaskConfig& getConfig() const { return config; }
+
+    // Associates a FreeRTOS task handle, for the stack high-water mark
+    void attach(void* taskHandle) { handle.store(taskHandle, std::memory_order_relaxed); }
+    void attachCurrentTask();
+    bool attached() const { return handle.load(std::memory_order_relaxed) != nullptr; }
+
+    // Bracket the task's useful work; the time between is counted as busy. A stop without a start is ignored.
+    void workStart();
+    void workStop();
+
+    // Call after each wake-up from a notification, with the number of notifications pending at the time (the return
+    // value of ulTaskNotifyTake(pdTRUE, ...))
+    void woke(uint32_t notifications);
+
+    // Smallest free stack seen so far in bytes, or -1 if unknown
+    int32_t getStackFreeMin() const;
+    // Busy time and missed notifications since the last call, then restarts both
+    uint32_t takeBusyUs() { return busyUs.exchange(0, std::memory_order_relaxed); }
+    uint32_t takeMissed() { return missed.exchange(0, std::memory_order_relaxed); }
+
+private:
+    friend class TaskMonitor;
+    explicit TaskStats(const TaskConfig& config) : config(config) {}
+
+    TaskConfig config;
+    std::atomic<void*> handle{nullptr};
+    uint32_t workStartUs = 0;
+    bool working = false;
+    std::atomic<uint32_t> busyUs{0};
+    std::atomic<uint32_t> missed{0};
+};
+
+// One task's statistics over a report interval
+struct TaskReport {
+    TaskConfig config;
+    int32_t stackFreeMin; // bytes, or -1 if unknown
+    uint32_t busyUs;
+    uint32_t intervalUs; // since the previous report
+    uint32_t missed;
+};
+
+class TaskMonitor {
+public:
+    TaskMonitor() = default;
+    TaskMonitor(const TaskMonitor&) = delete;
+    void operator=(const TaskMonitor&) = delete;
+
+    // Adds a task to the report, returning the same stats for the same config name. Tasks are added from setup code,
+    // not concurrently.
+    TaskStats& add(const TaskConfig& config);
+
+    // Statistics of every task since the previous report, restarting the busy time and missed counts
+    std::vector<TaskReport> takeReport();
+    void printReport();
+
+private:
+    static constexpr std::size_t maxTasks = 8;
+
+    std::array<std::unique_ptr<TaskStats>, maxTasks> tasks{};
+    std::size_t taskCount = 0;
+    uint32_t lastReportUs = 0;
+};
+
+class TaskMonitorSingleton {
+public:
+    static TaskMonitor& get();
+    TaskMonitorSingleton(const TaskMonitorSingleton&) = delete;
+    void operator=(const TaskMonitorSingleton&) = delete;
+};
+
+// Creates a FreeRTOS task as configured and adds it to the monitor. Returns the task handle, or nullptr on failure and
+// always on desktop, where there are no FreeRTOS tasks.
+void* spawn(const TaskConfig& config, void (*function)(void*), void* parameter);
+
+} // namespace tasks
+
+#endif // tasks_h
@@ -0,0 +1,225 @@
+#ifndef telemetry_h
+#define telemetry_h
+
+/* Project Scope */
+#include "memoryPlacement.h"
+#include "spscRing.h"
+
+/* Libraries */
+#include <etl/span.h>
+
+/* C++ Standard Library */
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// The device streams binary telemetry instead of printing text reports, unless PIXELCLOCK_TEXT_REPORTS is defined.
+// The desktop build always prints text.
+#if !defined(PIXELCLOCK_DESKTOP) && !defined(PIXELCLOCK_TEXT_REPORTS)
+#define PIXELCLOCK_BINARY_TELEMETRY
+#endif
+
+/**
+ * Binary telemetry.
+ *
+ * Formatting the text reports costs milliseconds of the render loop, and writing them blocks it whenever the UART
+ * falls behind. Instead, the loop fills in a Sample of raw counters every sampleInterval, encodes it into a compact
+ * frame (a few hundred bytes, no formatting) and queues it on a ring; a low-priority background task drains the ring
+ * to the serial port. If the ring is full the sample is dropped and counted, so the render loop never waits.
+ *
+ * Frames are:
+ *
+ *     sync (0xA5 0x5A) | version | type | payload length (uint16) | payload | CRC-16/CCITT-FALSE (uint16)
+ *
+ * with every multi-byte value little-endian and the CRC covering version to the end of the payload. The sync bytes
+ * let a decoder join mid-stream and skip anything else on the port (e.g. boot messages); a frame with a bad CRC is
+ * discarded and the search for the next sync restarts one byte later. The version is bumped whenever a payload layout
+ * changes, and a decoder skips frames of versions it does not know.
+ *
+ * Trace names are only sent in a separate frame every few seconds, so each sample carries just the numbers, in the
+ * order of the last names frame. The rest of the text report (memory placement, tasks and scoped traces) goes out as
+ * its own frames at the same low rate, names included. A timeline dump (TRACE DUMP, see timeline.h) is sent as a run
+ * of timeline frames too, so its JSON never interleaves with other frames on the port. tools/telemetryDecoder.cpp turns
+ * a captured stream into CSV for graphing, and writes any timeline it contains to a file.
+ */
+namespace tracing {
+class Timeline;
+}
+
+namespace telemetry {
+
+constexpr uint8_t protocolVersion = 1;
+constexpr std::array<uint8_t, 2> syncBytes{0xA5, 0x5A};
+constexpr std::size_t headerSize = 6;
+constexpr std::size_t crcSize = 2;
+
+enum class FrameType : uint8_t { sample = 1, traceNames = 2, placement = 3, tasks = 4, scopedTraces = 5, timeline = 6 };
+
+// Timing of one InstrumentationTrace over a sample interval, in microseconds
+struct TraceSummary {
+    uint32_t hits;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t avgUs;
+    uint32_t p99Us; // 0 for traces without percentiles
+};
+
+struct Sample {
+    static constexpr std::size_t maxTraces = 32;
+
+    uint32_t sequence; // Increments with every sample, so gaps show dropped frames
+    uint32_t timeMs;
+    uint32_t overruns;      // Frame scheduler overruns, since boot
+    uint32_t skippedFrames; // Frame scheduler skipped frames, since boot
+    uint32_t dropped;       // Telemetry frames dropped because the ring was full, since boot
+    uint32_t freeHeap;      // bytes, or 0 if unknown
+    uint32_t minFreeHeap;
+    uint32_t freePsram;
+    uint8_t traceCount;
+    std::array<TraceSummary, maxTraces> traces;
+};
+
+// One line of memory::getPlacementReport()
+struct PlacementEntry {
+    std::string name;
+    uint8_t placement; // memory::Placement
+    uint8_t region;    // memory::Region
+    uint32_t liveBytes;
+    uint32_t liveCount;
+    uint32_t fallbacks;
+};
+
+// One line of tasks::TaskMonitor::takeReport()
+struct TaskEntry {
+    std::string name;
+    int8_t core;
+    uint8_t priority;
+    uint32_t stackBytes;
+    int32_t stackFreeMin; // -1 if unknown
+    uint32_t busyUs;
+    uint32_t intervalUs;
+    uint32_t missed;
+};
+
+// One line of tracing::takeReport()
+struct ScopedTraceEntry {
+    std::string name;
+    uint32_t hits;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t avgUs;
+};
+
+// A piece of a timeline's Chrome trace JSON, which is sent in order over as many frames as it needs
+struct TimelineChunk {
+    static constexpr std::size_t maxSize = 1024;
+
+    bool first; // Starts a new trace
+    bool last;  // Completes it
+    std::string json;
+};
+
+constexpr std::size_t samplePayloadSize = 8 * 4 + 1 + Sample::maxTraces * 5 * 4;
+constexpr std::size_t maxPayloadSize = 2048;
+constexpr std::size_t maxFrameSize = headerSize + maxPayloadSize + crcSize;
+
+uint16_t crc16(etl::span<const uint8_t> data, uint16_t crc = 0xFFFF);
+
+// Encode a frame into 'out', returning its size, or 0 if it does not fit. Only the first traceCount traces are sent,
+// lists are cut at 255 entries and names are truncated to 255 bytes.
+std::size_t encode(const Sample& sample, etl::span<uint8_t> out);
+std::size_t encode(const std::vector<std::string>& traceNames, etl::span<uint8_t> out);
+std::size_t encode(const std::vector<PlacementEntry>& placement, etl::span<uint8_t> out);
+std::size_t encode(const std::vector<TaskEntry>& tasks, etl::span<uint8_t> out);
+std::size_t encode(const std::vector<ScopedTraceEntry>& scopedTraces, etl::span<uint8_t> out);
+std::size_t encode(const TimelineChunk& chunk, etl::span<uint8_t> out);
+
+/**
+ * @brief Stream decoder, fed bytes in chunks of any size.
+ */
+class Decoder {
+public:
+    std::function<void(const Sample&)> onSample;
+    // Called with the trace names whenever a names frame arrives
+    std::function<void(const std::vector<std::string>&)> onTraceNames;
+    std::function<void(const std::vector<PlacementEntry>&)> onPlacement;
+    std::function<void(const std::vector<TaskEntry>&)> onTasks;
+    std::function<void(const std::vector<ScopedTraceEntry>&)> onScopedTraces;
+    std::function<void(const TimelineChunk&)> onTimelineChunk;
+
+    void feed(etl::span<const uint8_t> data);
+
+    const std::vector<std::string>& getTraceNames() const { return traceNames; }
+    uint32_t getFrames() const { return frames; }
+    uint32_t getCrcErrors() const { return crcErrors; }
+    uint32_t getUnsupportedFrames() const { return unsupportedFrames; }
+    // Bytes skipped while looking for the start of a frame
+    uint32_t getSkippedBytes() const { return skippedBytes; }
+
+private:
+    // Decodes frames from the front of the buffer while there are complete ones, returning the bytes consumed
+    std::size_t decodeBuffered();
+    void dispatch(uint8_t version, FrameType type, etl::span<const uint8_t> payload);
+
+    std::vector<uint8_t> buffer;
+    std::vector<std::string> traceNames;
+    uint32_t frames = 0;
+    uint32_t crcErrors = 0;
+    uint32_t unsupportedFrames = 0;
+    uint32_t skippedBytes = 0;
+};
+
+/**
+ * @brief Queue of encoded frames between the render loop and the background task that sends them.
+ *
+ * publish() is called by a single producer (the render loop) and never blocks. drain() is called by a single consumer:
+ * on ESP32 the telemetry task, started by the first publish(); on desktop, whoever wants the bytes.
+ */
+class TelemetryStream {
+public:
+    static constexpr std::size_t ringSize = 8192;
+
+    TelemetryStream();
+    TelemetryStream(const TelemetryStream&) = delete;
+    void operator=(const TelemetryStream&) = delete;
+
+    // Queue a frame, returning false if there was no room and it was dropped
+    template <typename Content> bool publish(const Content& content) {
+        return queue({scratch.data(), encode(content, scratch)});
+    }
+    uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Send the timeline's Chrome trace as timeline frames. Unlike publish() this waits for room in the ring rather than
+    // dropping anything, so it holds up the caller until the whole trace is queued.
+    void publishTimeline(tracing::Timeline& timeline);
+
+    // Pass everything queued to 'sink', in up to two contiguous pieces. Returns the number of bytes passed.
+    std::size_t drain(const std::function<void(etl::span<const uint8_t>)>& sink);
+
+private:
+    bool queue(etl::span<const uint8_t> frame);
+    void waitForRoom(std::size_t bytes);
+    void startTask();
+
+    memory::PlacedVector<uint8_t> storage{ringSize, {memory::Placement::bulk, "Telemetry ring"}};
+    SpscRing<uint8_t> ring{storage.data(), storage.size()};
+    std::array<uint8_t, maxFrameSize> scratch{};
+    std::atomic<uint32_t> dropped{0};
+    bool taskStarted = false;
+    void* task = nullptr;
+};
+
+class TelemetrySingleton {
+public:
+    static TelemetryStream& get();
+    TelemetrySingleton(const TelemetrySingleton&) = delete;
+    void operator=(const TelemetrySingleton&) = delete;
+};
+
+} // namespace telemetry
+
+#endif // telemetry_h
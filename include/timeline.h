@@ -0,0 +1,110 @@
+#ifndef timeline_h
+#define timeline_h
+
+/* Project Scope */
+#include "memoryPlacement.h"
+
+/* C++ Standard Library */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+/**
+ * Event timeline, for seeing how work on different tasks and cores lines up.
+ *
+ * While recording, the start and end of every timed InstrumentationTrace and scoped trace (PIXELCLOCK_TRACE_SCOPE) is
+ * written to a fixed-size ring with the time, task and core. Any task can record without locks: each event claims
+ * the next slot with a single atomic increment, and each slot has its own sequence tag so the dump skips a slot that
+ * is being rewritten rather than reading it torn. Once the ring is full the oldest events are overwritten, so a dump
+ * always holds the most recent 'capacity' events.
+ *
+ * The dump is Chrome trace event JSON, which chrome://tracing and ui.perfetto.dev open directly. Over serial, send
+ * "TRACE START" then "TRACE DUMP". On desktop, set PIXELCLOCK_TRACE_FILE: recording starts at the first LoopTimeManager
+ * report, and the timeline is written to that file at every report after it.
+ */
+namespace tracing {
+
+struct TimelineEvent {
+    enum class Phase : uint8_t { begin, end };
+
+    const char* name; // Must outlive the timeline, e.g. a string literal or a trace's name
+    uint32_t timeUs;  // micros(), which unlike the cycle counter is common to both cores
+    uint32_t thread;  // Task (ESP32) or thread (desktop) identifier
+    uint8_t core;
+    Phase phase;
+};
+
+class Timeline {
+public:
+    static constexpr std::size_t capacity = 1024;
+
+    Timeline();
+    Timeline(const Timeline&) = delete;
+    void operator=(const Timeline&) = delete;
+
+    void start();
+    void stop();
+    bool recording() const { return active.load(std::memory_order_relaxed); }
+
+    void record(const char* name, TimelineEvent::Phase phase);
+
+    // Calls 'visit' with each event held, oldest first
+    void forEachEvent(const std::function<void(const TimelineEvent&)>& visit) const;
+
+    // Writes the events held as Chrome trace JSON, a piece at a time. Recording is paused meanwhile.
+    void writeChromeTrace(const std::function<void(const std::string&)>& write);
+
+private:
+    static_assert((capacity & (capacity - 1)) == 0, "Timeline capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<TimelineEvent>, "Timeline slots copy events word by word");
+    static constexpr std::size_t wordCount = (sizeof(TimelineEvent) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    struct Slot {
+        std::atomic<uint32_t> tag{0}; // 1 + the event number held, or 0 while being written
+        std::atomic<uint32_t> words[wordCount]{};
+    };
+
+    std::atomic<bool> active{false};
+    std::atomic<uint32_t> next{0};
+    // About 24 kB, and only touched while recording, so it lives in PSRAM
+    memory::PlacedVector<Slot> slots{capacity, {memory::Placement::bulk, "Timeline"}};
+};
+
+class TimelineSingleton {
+public:
+    static Timeline& get();
+    TimelineSingleton(const TimelineSingleton&) = delete;
+    void operator=(const TimelineSingleton&) = delete;
+};
+
+// Start or stop recording trace edges into the timeline singleton
+void startTimeline();
+void stopTimeline();
+
+#ifdef PIXELCLOCK_DESKTOP
+// If PIXELCLOCK_TRACE_FILE is set, the first call starts recording and later calls rewrite that file with the timeline
+void updateTimelineFile();
+#endif
+
+// Set while the timeline singleton is recording, so trace edges only pay for a relaxed load when it is not
+extern std::atomic<bool> timelineRecording;
+
+inline void timelineBegin(const char* name) {
+    if (timelineRecording.load(std::memory_order_relaxed)) {
+        TimelineSingleton::get().record(name, TimelineEvent::Phase::begin);
+    }
+}
+
+inline void timelineEnd(const char* name) {
+    if (timelineRecording.load(std::memory_order_relaxed)) {
+        TimelineSingleton::get().record(name, TimelineEvent::Phase::end);
+    }
+}
+
+} // namespace tracing
+
+#endif // timeline_h
@@ -0,0 +1,149 @@
+#ifndef tracing_h
+#define tracing_h
+
+/* Project Scope */
+#include "timeline.h"
+
+/* Arduino Core */
+#include <Arduino.h>
+
+/* C++ Standard Library */
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#if defined(PIXELCLOCK_DESKTOP) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define PIXELCLOCK_TRACING_RDTSC
+#elif defined(PIXELCLOCK_DESKTOP)
+#include <chrono>
+#endif
+
+/**
+ * Scoped tracing for hot paths.
+ *
+ * PIXELCLOCK_TRACE_SCOPE("name") times the rest of the enclosing scope:
+ *
+ *     void Effect::update() {
+ *         PIXELCLOCK_TRACE_SCOPE("Effect update");
+ *         ...
+ *     }
+ *
+ * Each call site gets a static TracePoint holding a pointer to its name (string literals are interned by the linker,
+ * so nothing is copied or allocated), which adds itself to a global list the first time it runs. Entering and leaving
+ * the scope cost one cycle counter read each (ESP.getCycleCount() on ESP32, rdtsc on x86 desktops) and cycles are only
+ * converted to microseconds at report time.
+ *
+ * Define PIXELCLOCK_NO_TRACING to compile every scoped trace out entirely.
+ *
+ * Like InstrumentationTrace, a trace point's statistics are not synchronised: a point hit from several tasks may
+ * occasionally lose an update, which is acceptable for profiling.
+ */
+namespace tracing {
+
+// The ESP32 counter is 32 bits, wrapping every ~18 s at 240 MHz, which is far longer than any traced scope. Desktop
+// counters run at GHz rates and would wrap within a few seconds at 32 bits, so they keep all 64.
+#ifdef PIXELCLOCK_DESKTOP
+using Cycles = uint64_t;
+#else
+using Cycles = uint32_t;
+#endif
+
+inline Cycles cycles() {
+#if !defined(PIXELCLOCK_DESKTOP)
+    return ESP.getCycleCount();
+#elif defined(PIXELCLOCK_TRACING_RDTSC)
+    return __rdtsc();
+#else
+    using namespace std::chrono;
+    return static_cast<Cycles>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Counter rate, measured once on desktop
+float cyclesPerMicrosecond();
+
+class TracePoint {
+public:
+    explicit TracePoint(const char* name);
+    TracePoint(const TracePoint&) = delete;
+    void operator=(const TracePoint&) = delete;
+
+    void record(Cycles elapsed) {
+        hits++;
+        sum += elapsed;
+        if (elapsed < min || hits == 1) { min = elapsed; }
+        if (elapsed > max) { max = elapsed; }
+    }
+    void reset() {
+        hits = 0;
+        sum = 0;
+        min = 0;
+        max = 0;
+    }
+
+    const char* getName() const { return name; }
+    uint32_t getHits() const { return hits; }
+    // In cycles of the trace counter
+    Cycles getMin() const { return min; }
+    Cycles getMax() const { return max; }
+    uint64_t getSum() const { return sum; }
+    TracePoint* getNext() const { return next; }
+
+private:
+    const char* name;
+    uint32_t hits = 0;
+    uint64_t sum = 0;
+    Cycles min = 0;
+    Cycles max = 0;
+    TracePoint* next = nullptr;
+};
+
+// First of all trace points that have run so far, most recently registered first
+TracePoint* firstTracePoint();
+
+class ScopedTrace {
+public:
+    explicit ScopedTrace(TracePoint& point) : point(point), start(cycles()) { timelineBegin(point.getName()); }
+    ~ScopedTrace() {
+        point.record(cycles() - start);
+        timelineEnd(point.getName());
+    }
+    ScopedTrace(const ScopedTrace&) = delete;
+    void operator=(const ScopedTrace&) = delete;
+
+private:
+    TracePoint& point;
+    const Cycles start;
+};
+
+struct TracePointReport {
+    const char* name;
+    uint32_t hits;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t avgUs;
+};
+
+// Statistics of every trace point that has run, in microseconds, then resets them
+std::vector<TracePointReport> takeReport();
+// Prints hits, min, max and average in microseconds for every trace point, then resets them
+void printReport();
+
+} // namespace tracing
+
+#define PIXELCLOCK_TRACE_CONCAT_INNER(a, b) a##b
+#define PIXELCLOCK_TRACE_CONCAT(a, b) PIXELCLOCK_TRACE_CONCAT_INNER(a, b)
+
+#ifdef PIXELCLOCK_NO_TRACING
+#define PIXELCLOCK_TRACE_SCOPE(name) static_cast<void>(0)
+#else
+// __COUNTER__ rather than __LINE__, so two traces on one line (or from one line of another macro) don't collide
+#define PIXELCLOCK_TRACE_SCOPE(name) PIXELCLOCK_TRACE_SCOPE_ID(name, __COUNTER__)
+#define PIXELCLOCK_TRACE_SCOPE_ID(name, id)                                                                            \
+    static ::tracing::TracePoint PIXELCLOCK_TRACE_CONCAT(pixelclockTracePoint, id){name};                              \
+    const ::tracing::ScopedTrace PIXELCLOCK_TRACE_CONCAT(pixelclockTraceScope, id) {                                   \
+        PIXELCLOCK_TRACE_CONCAT(pixelclockTracePoint, id)                                                              \
+    }
+#endif
+
+#endif // tracing_h
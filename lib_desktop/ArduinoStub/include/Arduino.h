@@ -33,6 +33,9 @@ typedef unsigned int word;
 #define bitToggle(value, bit) ((value) ^= (1UL << (bit)))
 #define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
 
+// there is no separate instruction RAM for interrupt handlers on desktop
+#define IRAM_ATTR
+
 // stub out Arduino functions in x86 environment
 inline unsigned long millis() {
     using namespace std::chrono;
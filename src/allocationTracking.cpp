@@ -0,0 +1,186 @@
+/* Project Scope */
+#include "allocationTracking.h"
+
+/* C++ Standard Library */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace alloc {
+
+namespace {
+
+struct AtomicCounters {
+    std::atomic<uint32_t> allocations{0};
+    std::atomic<uint32_t> frees{0};
+    std::atomic<uint32_t> bytes{0};
+};
+
+// Constant-initialised, so allocations made during static initialisation are safe to count
+AtomicCounters counters[subsystemCount];
+thread_local Subsystem currentTag = Subsystem::other;
+
+inline AtomicCounters& countersFor(Subsystem subsystem) { return counters[static_cast<std::size_t>(subsystem)]; }
+
+// Stored just before each block, so a free is counted against the subsystem that made the allocation
+struct Header {
+    void* raw; // what malloc returned, as over-aligned blocks start further in
+    Subsystem tag;
+};
+
+constexpr std::size_t defaultAlignment = alignof(std::max_align_t);
+// Space reserved before a block of default alignment, rounded up so the block stays aligned
+constexpr std::size_t headerSpace = (sizeof(Header) + defaultAlignment - 1) & ~(defaultAlignment - 1);
+
+void* trackedAllocate(std::size_t size, std::size_t alignment = defaultAlignment) {
+    const std::size_t padding = alignment > defaultAlignment ? alignment : 0;
+    if (size > SIZE_MAX - headerSpace - padding) { return nullptr; }
+    auto* raw = static_cast<uint8_t*>(std::malloc(size + headerSpace + padding));
+    if (!raw) { return nullptr; }
+
+    uintptr_t block = reinterpret_cast<uintptr_t>(raw) + headerSpace;
+    if (padding) { block = (block + alignment - 1) & ~(uintptr_t(alignment) - 1); }
+    Header* header = reinterpret_cast<Header*>(block) - 1;
+    header->raw = raw;
+    header->tag = currentTag;
+
+    auto& c = countersFor(currentTag);
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    c.bytes.fetch_add(static_cast<uint32_t>(size), std::memory_order_relaxed);
+    return reinterpret_cast<void*>(block);
+}
+
+void trackedFree(void* ptr) {
+    if (!ptr) { return; }
+    const Header* header = static_cast<const Header*>(ptr) - 1;
+    countersFor(header->tag).frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(header->raw);
+}
+
+void* allocateOrThrow(std::size_t size, std::size_t alignment = defaultAlignment) {
+    void* p = trackedAllocate(size, alignment);
+    if (!p) {
+#if defined(__cpp_exceptions)
+        throw std::bad_alloc();
+#else
+        std::abort();
+#endif
+    }
+    return p;
+}
+
+} // namespace
+
+const char* subsystemName(Subsystem subsystem) {
+    switch (subsystem) {
+    case Subsystem::other:
+        return "Other";
+    case Subsystem::mode:
+        return "Mode";
+    case Subsystem::effect:
+        return "Effect";
+    case Subsystem::audio:
+        return "Audio";
+    case Subsystem::display:
+        return "Display";
+    case Subsystem::count:
+        break;
+    }
+    return "Unknown";
+}
+
+ScopeTag::ScopeTag(Subsystem subsystem) : previous(currentTag) { currentTag = subsystem; }
+
+ScopeTag::~ScopeTag() { currentTag = previous; }
+
+Counters getCounters(Subsystem subsystem) {
+    const auto& c = counters[static_cast<std::size_t>(subsystem)];
+    return {
+        c.allocations.load(std::memory_order_relaxed),
+        c.frees.load(std::memory_order_relaxed),
+        c.bytes.load(std::memory_order_relaxed)};
+}
+
+Counters getTotalCounters() {
+    Counters total{0, 0, 0};
+    for (std::size_t i = 0; i < subsystemCount; i++) {
+        Counters c = getCounters(static_cast<Subsystem>(i));
+        total.allocations += c.allocations;
+        total.frees += c.frees;
+        total.bytes += c.bytes;
+    }
+    return total;
+}
+
+AllocationMonitor::AllocationMonitor() {
+    traceAllocations.reserve(subsystemCount);
+    for (std::size_t i = 0; i < subsystemCount; i++) {
+        auto subsystem = static_cast<Subsystem>(i);
+        traceAllocations.emplace_back(std::string("Allocations - ") + subsystemName(subsystem) + " (count)");
+        countersLastFrame[i] = getCounters(subsystem);
+    }
+    bytesLastFrame = getTotalCounters().bytes;
+}
+
+void AllocationMonitor::endFrame() {
+    for (std::size_t i = 0; i < subsystemCount; i++) {
+        Counters now = getCounters(static_cast<Subsystem>(i));
+        traceAllocations[i].update(now.allocations - countersLastFrame[i].allocations);
+        countersLastFrame[i] = now;
+    }
+    uint32_t bytesNow = getTotalCounters().bytes;
+    traceBytes.update(bytesNow - bytesLastFrame);
+    bytesLastFrame = bytesNow;
+}
+
+std::vector<InstrumentationTrace*> AllocationMonitor::getInstrumentation() {
+    std::vector<InstrumentationTrace*> traces;
+    for (auto& trace : traceAllocations) { traces.push_back(&trace); }
+    traces.push_back(&traceBytes);
+    return traces;
+}
+
+AllocationMonitor& AllocationMonitorSingleton::get() {
+    static AllocationMonitor instance;
+    return instance;
+}
+
+} // namespace alloc
+
+/* Global allocation functions
+ *
+ * Replacing these is enough to catch every C++ heap allocation (containers, std::string, std::function, make_shared
+ * etc.), over-aligned ones included. Frees are counted against the subsystem that made the allocation.
+ */
+
+void* operator new(std::size_t size) { return alloc::allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return alloc::allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return alloc::trackedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return alloc::trackedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t al) {
+    return alloc::allocateOrThrow(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al) {
+    return alloc::allocateOrThrow(size, static_cast<std::size_t>(al));
+}
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return alloc::trackedAllocate(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return alloc::trackedAllocate(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* ptr) noexcept { alloc::trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { alloc::trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { alloc::trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { alloc::trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { alloc::trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { alloc::trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { alloc::trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { alloc::trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { alloc::trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { alloc::trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { alloc::trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { alloc::trackedFree(ptr); }
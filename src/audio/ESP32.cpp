@@ -1,32 +1,42 @@
 /* Project Scope */
 #include "audio/ESP32.h"
 #include "FMTWrapper.h"
+#include "allocationTracking.h"
 #include "instrumentation.h"
+#include "memoryPlacement.h"
 #include "pinout.h"
+#include "tasks.h"
+#include "telemetry.h"
 #include "utility.h"
 
 /* Libraries */
 #include "AudioTools.h"
 #include "BluetoothA2DPSink.h"
-#include <arduinoFFT.h>
-#include <etl/circular_buffer.h>
 
 /* C++ Standard Library */
+#include <algorithm>
+#include <new>
 #include <numeric>
 
 void read_data_stream(const uint8_t* data, uint32_t length) { AudioSingleton::get().a2dp_callback(data, length); }
 
 void AudioESP32::a2dp_callback(const uint8_t* data, uint32_t length) {
 
+    alloc::ScopeTag tag(alloc::Subsystem::audio);
+
     traceCallbackTotal.start();
+    const uint32_t arrivalUs = micros();
     traceCallbackI2S.start();
     i2sOutput->write(data, length);
     traceCallbackI2S.stop();
 
     traceCallbackBuffer.start();
-    int16_t* samples = (int16_t*)data;
-    const uint32_t sample_count = length / 2;
-    for (uint32_t i = 0; i < sample_count; i++) { audioBuffer->push(samples[i]); }
+    const int16_t* samples = reinterpret_cast<const int16_t*>(data);
+    const std::size_t sampleCount = length / 2;
+    // if the processing task has fallen behind, drop whatever does not fit, keeping L/R pairs together
+    const std::size_t writable = std::min(sampleCount, audioBuffer->free()) & ~std::size_t(1);
+    blockTimestamps.written(writable, arrivalUs);
+    audioBuffer->write({samples, writable});
     traceCallbackBuffer.stop();
 
     if (audioProcessingTaskHandle) {
@@ -38,46 +48,30 @@ void AudioESP32::a2dp_callback(const uint8_t* data, uint32_t length) {
 
 AudioESP32::AudioESP32() {
 
-    acBuf = (AudioCharacteristics*)ps_calloc(audioHistorySize + 1, sizeof(AudioCharacteristics));
-    if (acBuf) {
-        printing::print("PSRAM buffer allocation success!\n");
-        audioCharacteristics = new etl::circular_buffer_ext<AudioCharacteristics>(acBuf, audioHistorySize);
-    } else {
-        printing::print("PSRAM buffer allocation fail!\n");
-        audioCharacteristics = new etl::circular_buffer<AudioCharacteristics, audioHistorySize>();
-    }
+    // Both are large and touched once per chunk, so they go to PSRAM and leave internal RAM to Bluetooth and DMA
+    acBuf = memory::allocateOrFail(sizeof(AudioHistory), memory::Placement::bulk, "Audio history");
+    audioCharacteristics = new (acBuf) AudioHistory();
 
-    audioBufferRaw = (int16_t*)ps_calloc(audioBufferSize + 1, sizeof(int16_t));
-    if (audioBufferRaw) {
-        printing::print("PSRAM buffer allocation success!\n");
-    } else {
-        printing::print("PSRAM buffer allocation fail!\n");
-        audioBufferRaw = (int16_t*)calloc(audioBufferSize + 1, sizeof(int16_t));
-    }
-    audioBuffer = new etl::circular_buffer_ext<int16_t>(audioBufferRaw, audioBufferSize);
+    audioBufferRaw = static_cast<int16_t*>(
+        memory::allocateOrFail((audioBufferSize + 1) * sizeof(int16_t), memory::Placement::bulk, "Audio sample ring"));
+    std::fill_n(audioBufferRaw, audioBufferSize + 1, 0);
+    audioBuffer = std::make_unique<SpscRing<int16_t>>(audioBufferRaw, audioBufferSize);
 
-    traces.reserve(6);
+    traces = analyzer.getInstrumentation();
     traces.push_back(&traceCallbackTotal);
     traces.push_back(&traceCallbackI2S);
     traces.push_back(&traceCallbackBuffer);
-    traces.push_back(&traceProcessVol);
-    traces.push_back(&traceProcessFFT);
-    traces.push_back(&traceProcessSpectrum);
 
     printing::print("Creating audio processing task... ");
-    auto taskCreated = xTaskCreatePinnedToCore(
+    audioProcessingTaskHandle = static_cast<TaskHandle_t>(tasks::spawn(
+        tasks::config::audio,
         [](void* o) {
+            alloc::ScopeTag tag(alloc::Subsystem::audio);
             while (1) { static_cast<AudioESP32*>(o)->audioProcessingTask(); }
-        },                          // Function to implement the task
-        "AudioUpdate",              // Name of the task
-        2048,                       // Stack size in words
-        this,                       // Task input parameter
-        10,                         // Priority of the task
-        &audioProcessingTaskHandle, // Task handle.
-        0                           // Core where the task should run
-    );
-
-    if (taskCreated == pdPASS) {
+        },
+        this));
+
+    if (audioProcessingTaskHandle) {
         printing::print("success!\n");
     } else {
         printing::print("failure!\n");
@@ -86,11 +80,11 @@ AudioESP32::AudioESP32() {
 
 AudioESP32::~AudioESP32() {
 
-    if (acBuf) { free(acBuf); }
-    free(audioCharacteristics);
+    audioCharacteristics->~AudioHistory();
+    memory::release(acBuf);
 
-    if (audioBufferRaw) { free(audioBufferRaw); }
-    free(audioBuffer);
+    audioBuffer.reset();
+    memory::release(audioBufferRaw);
 }
 
 void AudioESP32::begin() {
@@ -132,145 +126,34 @@ void AudioESP32::begin() {
     a2dpSink->start("MyMusic");
 
     printing::print("after a2dp\n");
-
-    FFT = std::make_unique<ArduinoFFT<float>>(vReal, vImag, fftSamples, fftSampleFreq, weighingFactors);
-
-    audioCharacteristicsSemaphore = xSemaphoreCreateMutex();
 }
 
 void AudioESP32::audioProcessingTask() {
 
-    uint32_t thread_notification = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-    // printing::print("audio task notified...\n");
-    // printing::print(fmt::format("AudioESP32::audioProcessingTask() - buffer = {}\n", audioBuffer->size()));
-
-    const int samplesToProcess = 2048;
-    while (audioBuffer->size() >= samplesToProcess) {
-
-        // printing::print(fmt::format(
-        //     "AudioESP32::audioProcessingTask(), buffer {} >= {}, processing buffer...\n", audioBuffer->size(),
-        //     samplesToProcess));
-
-        auto& samples = *audioBuffer;
-
-        traceProcessVol.start();
-
-        float vLeftAvg = 0;
-        float vRightAvg = 0;
-
-        // calculate average RMS magnitude for L/R channels
-        for (uint32_t i = 0; i < samplesToProcess; i += 2) {
-            vLeftAvg += samples[i] * samples[i];
-            vRightAvg += samples[i + 1] * samples[i + 1];
-        }
-
-        constexpr float fullscaleDiv = 1.0 / 32768;
-        int lrSamplesDiv2 = samplesToProcess / 4;
-        vLeftAvg = std::sqrt(vLeftAvg / lrSamplesDiv2) * fullscaleDiv;
-        vRightAvg = std::sqrt(vRightAvg / lrSamplesDiv2) * fullscaleDiv;
-
-        auto mag2db = [](float mag) -> float {
-            if (mag < 1e-3) {
-                return -60.0;
-            } else {
-                return 20 * std::log10(mag);
-            }
-        };
-
-        // convert to dB
-        vLeftAvg = mag2db(vLeftAvg);
-        vRightAvg = mag2db(vRightAvg);
-
-        traceProcessVol.stop();
-        traceProcessFFT.start();
-
-        int sourceIdx = 0;
-        for (uint32_t i = 0; i < fftSamples; i++) {
-
-            if (sourceIdx < samplesToProcess) {
-                // convert stereo samples to mono
-                vReal[i] = (uint32_t(samples[sourceIdx]) + samples[sourceIdx + 1]) / 2;
-            } else {
-                vReal[i] = 0;
-            }
-            vImag[i] = 0;
-            sourceIdx += 2;
-        }
-
-        FFT->dcRemoval();
-        FFT->windowing(FFTWindow::Hamming, FFTDirection::Forward); /* Weigh data */
-        FFT->compute(FFTDirection::Forward);                       /* Compute FFT */
-        FFT->complexToMagnitude();                                 /* Compute magnitudes */
-
-        traceProcessFFT.stop();
-        traceProcessSpectrum.start();
-
-        // Fill the audioSpectrum vector with data.
-        auto spectrum = etl::array<float, audioSpectrumBins>();
-        spectrum.fill(0);
-
-        float prevMax = 0.0;
-        if (!audioCharacteristics->empty()) { prevMax = audioCharacteristics->back().spectrumMax; }
-
-        // Bin FFT results
-        for (int i = 5; i < (fftSamples / 2) - 1; i++) {
-            float freq = i * fftFrequencyResolution;
-            int binIdx = std::floor(freq / audioSpectrumBinWidth);
-            // int binIdx = i / audioSpectrumBinSize;
-            if (binIdx < spectrum.size()) {
-                float val = vReal[i] / audioSpectrumBinSize;
-
-                // basic noise filter
-                if (val > prevMax * 0.02) { spectrum[binIdx] += val; }
-            }
-        }
-
-        float maxThisTime = *std::max_element(spectrum.begin(), spectrum.end());
-        float avgMax = utility::sum_members(*audioCharacteristics, &AudioCharacteristics::spectrumMax) /
-                       audioCharacteristics->size();
-
-        float maxScale = 6000;
-        float scaleFactor = maxScale / avgMax;
-
-        std::transform(
-            spectrum.begin(),
-            spectrum.end(),
-            spectrum.begin(),
-            std::bind(std::multiplies<float>(), std::placeholders::_1, scaleFactor));
-
-        traceProcessSpectrum.stop();
-
-        AudioCharacteristics c{};
-        c.volumeLeft = vLeftAvg;
-        c.volumeRight = vRightAvg;
-        c.spectrumMax = maxThisTime;
-        c.spectrum = spectrum;
-
-        xSemaphoreTake(audioCharacteristicsSemaphore, portMAX_DELAY);
-        audioCharacteristics->push(c);
-        xSemaphoreGive(audioCharacteristicsSemaphore);
-
-        samples.pop(samplesToProcess);
-    }
+    const uint32_t notifications = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    taskStats.woke(notifications);
+
+    taskStats.workStart();
+    const bool events = analyzer.process(*audioBuffer, blockTimestamps, *audioCharacteristics, millis());
+    taskStats.workStop();
 
-    // printing::print(fmt::format(
-    //     "AudioESP32::audioProcessingTask(), stack high water mark = {}\n", uxTaskGetStackHighWaterMark(nullptr)));
+    if (events) { notifyEvents(); }
 }
 
 void AudioESP32::update() {
 
+#ifndef PIXELCLOCK_BINARY_TELEMETRY
     if (millis() - statReportLastTime > statReportInterval) {
 
         printing::print(fmt::format(
             "Volume: L={:.1f} R={:.1f}\n",
-            audioCharacteristics->back().volumeLeft,
-            audioCharacteristics->back().volumeRight));
+            audioCharacteristics->latest().volumeLeft,
+            audioCharacteristics->latest().volumeRight));
 
         statReportLastTime = millis();
     }
+#endif
 }
 
-void AudioESP32::lockMutex() { xSemaphoreTake(audioCharacteristicsSemaphore, portMAX_DELAY); }
-void AudioESP32::releaseMutex() { xSemaphoreGive(audioCharacteristicsSemaphore); }
 
 std::vector<InstrumentationTrace*> AudioESP32::getInstrumentation() { return traces; }
\ No newline at end of file
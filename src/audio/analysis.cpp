@@ -0,0 +1,129 @@
+/* Project Scope */
+#include "audio/analysis.h"
+#include "fixedPoint.h"
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cmath>
+
+namespace analysis {
+
+namespace {
+
+constexpr float fullscaleDiv = 1.0f / 32768;
+
+constexpr double fftBinHz = double(fftSampleFreq) / fftSamples;
+constexpr auto spectrumEdges =
+    makeBinEdges<audioSpectrumBins>(audioSpectrumSpacing, audioSpectrumMinFreq, audioSpectrumMaxFreq);
+constexpr std::size_t spectrumMapSize = countBinMapEntries(spectrumEdges, fftBinHz, fftSamples / 2);
+constexpr BinMap<spectrumMapSize> spectrumMap = makeBinMap<spectrumMapSize>(spectrumEdges, fftBinHz, fftSamples / 2);
+
+float mag2db(float mag) {
+    if (mag < 1e-3) {
+        return -60.0;
+    } else {
+        return 20 * std::log10(mag);
+    }
+}
+
+struct ChannelEnergy {
+    uint64_t left;  // Sum of squared left samples
+    uint64_t right; // Sum of squared right samples
+    std::size_t frames;
+};
+
+// Deinterleaves 'interleaved' into mono[f] = mix(left, right) while summing the energy of each channel, so the samples
+// are only read once. Each contiguous part is handled by a plain indexed loop with integer accumulators, which
+// compilers can vectorise.
+template <typename Sample, typename Mix>
+ChannelEnergy mixDownWith(const SampleView& interleaved, etl::span<Sample> mono, Mix mix) {
+    ChannelEnergy energy{0, 0, 0};
+    std::size_t written = 0;
+    for (etl::span<const int16_t> part : {interleaved.first, interleaved.second}) {
+        const int16_t* in = part.data();
+        const std::size_t frames = part.size() / 2;
+        const std::size_t mixed = std::min(frames, mono.size() - written);
+        Sample* out = mono.data() + written;
+
+        for (std::size_t f = 0; f < mixed; f++) {
+            const int32_t left = in[2 * f];
+            const int32_t right = in[2 * f + 1];
+            energy.left += uint32_t(left * left);
+            energy.right += uint32_t(right * right);
+            out[f] = mix(left, right);
+        }
+        // frames beyond the end of 'mono' still count towards the volume
+        for (std::size_t f = mixed; f < frames; f++) {
+            const int32_t left = in[2 * f];
+            const int32_t right = in[2 * f + 1];
+            energy.left += uint32_t(left * left);
+            energy.right += uint32_t(right * right);
+        }
+
+        written += mixed;
+        energy.frames += frames;
+    }
+    std::fill(mono.begin() + written, mono.end(), Sample(0));
+    return energy;
+}
+
+} // namespace
+
+Volume mixDown(const SampleView& interleaved, etl::span<float> mono) {
+    const ChannelEnergy energy =
+        mixDownWith(interleaved, mono, [](int32_t left, int32_t right) { return float(left + right) * 0.5f; });
+    if (energy.frames == 0) { return {mag2db(0), mag2db(0)}; }
+
+    auto rms = [&](uint64_t sum) { return float(std::sqrt(double(sum) / energy.frames)) * fullscaleDiv; };
+    return {mag2db(rms(energy.left)), mag2db(rms(energy.right))};
+}
+
+Volume mixDown(const SampleView& interleaved, etl::span<int16_t> mono) {
+    const ChannelEnergy energy =
+        mixDownWith(interleaved, mono, [](int32_t left, int32_t right) { return int16_t((left + right) >> 1); });
+    if (energy.frames == 0) { return {mag2db(0), mag2db(0)}; }
+
+    // RMS with 8 fractional bits, so quiet signals keep some resolution
+    auto rms = [&](uint64_t sum) { return fixed::isqrt((sum / energy.frames) << 16) * (fullscaleDiv / 256); };
+    return {mag2db(rms(energy.left)), mag2db(rms(energy.right))};
+}
+
+void binSpectrum(etl::span<const float> magnitudes, float prevMax, Spectrum& spectrum) {
+    spectrum.fill(0);
+    const float threshold = prevMax * 0.02f;
+    for (const BinWeight& w : spectrumMap) {
+        const float mag = magnitudes[w.fftBin];
+
+        // basic noise filter
+        if (mag > threshold) { spectrum[w.displayBin] += mag * w.weight; }
+    }
+}
+
+void binSpectrum(etl::span<const uint32_t> magnitudes, float prevMax, Spectrum& spectrum) {
+    etl::array<uint64_t, audioSpectrumBins> totals;
+    totals.fill(0);
+
+    const uint32_t threshold = static_cast<uint32_t>(prevMax * 0.02f);
+    for (const BinWeight& w : spectrumMap) {
+        const uint32_t mag = magnitudes[w.fftBin];
+        if (mag > threshold) { totals[w.displayBin] += uint64_t(mag) * w.weightQ15; }
+    }
+
+    for (std::size_t b = 0; b < spectrum.size(); b++) { spectrum[b] = static_cast<float>(totals[b] >> 15); }
+}
+
+float perHopAlpha(float windowAlpha) {
+    // the old value keeps (1 - alpha) of its weight per update, so split that evenly across the hops
+    return 1 - std::pow(1 - windowAlpha, 1.0f / audioHopsPerWindow);
+}
+
+void AudioStatistics::update(AudioCharacteristics& c) {
+    spectrumMax.push(c.spectrumMax);
+    c.volumeLeftSmoothed = volumeLeft.update(c.volumeLeft);
+    c.volumeRightSmoothed = volumeRight.update(c.volumeRight);
+    volume.push((c.volumeLeft + c.volumeRight) / 2);
+    c.volumeMin = volume.getMin();
+    c.volumeMax = volume.getMax();
+}
+
+} // namespace analysis
@@ -0,0 +1,81 @@
+/* Project Scope */
+#include "audio/analyzer.h"
+#include "tracing.h"
+
+/* C++ Standard Library */
+#include <algorithm>
+
+namespace analysis {
+
+bool AudioAnalyzer::process(
+    SpscRing<int16_t>& samples,
+    BlockTimestamps& timestamps,
+    AudioHistory& history,
+    uint32_t timeMs) {
+    PIXELCLOCK_TRACE_SCOPE("Audio Analysis - Process");
+
+    const uint32_t publishedBefore = beatTracker.getPublishedCount();
+
+    // 'timeMs' is when the newest samples arrived, so the last window of the batch is stamped with it and each earlier
+    // one a hop before. The count is taken up front, as the producer may keep writing while the batch is analysed.
+    const std::size_t available = samples.size();
+    const uint32_t windows = available >= audioWindowSamples
+                                 ? static_cast<uint32_t>((available - audioWindowSamples) / audioHopSamples + 1)
+                                 : 0;
+
+    // analyse each full window in place, then slide forward by one hop
+    for (uint32_t i = 0; i < windows; i++) {
+        const auto window = samples.peek(audioWindowSamples);
+        const uint32_t ageMs = (windows - 1 - i) * audioHopFrames * 1000 / fftSampleFreq;
+        const uint32_t windowTimeMs = timeMs > ageMs ? timeMs - ageMs : 0;
+
+        AudioCharacteristics c = analyse(SampleView(window.first, window.second), windowTimeMs);
+        c.captureTimeUs = timestamps.arrivalOf(audioWindowSamples);
+        history.publish(c);
+
+        samples.skip(audioHopSamples);
+        timestamps.consumed(audioHopSamples);
+    }
+
+    return beatTracker.getPublishedCount() != publishedBefore;
+}
+
+AudioCharacteristics AudioAnalyzer::analyse(const SampleView& window, uint32_t timeMs) {
+    traceMixDown.start();
+    const Volume volume = mixDown(window, {fftInput.data(), fftInput.size()});
+    traceMixDown.stop();
+
+    traceFFT.start();
+    fft.magnitudes({fftInput.data(), fftInput.size()}, {fftMagnitudes.data(), fftMagnitudes.size()});
+    traceFFT.stop();
+
+    traceSpectrum.start();
+    Spectrum spectrum;
+    binSpectrum({fftMagnitudes.data(), fftMagnitudes.size()}, previousSpectrumMax, spectrum);
+
+    // onsets and tempo from the unscaled spectrum, so the auto-gain does not show up as flux
+    beatTracker.update(spectrum, timeMs);
+
+    const float maxThisTime = *std::max_element(spectrum.begin(), spectrum.end());
+    const float avgMax = statistics.getAverageSpectrumMax();
+
+    const float maxScale = 6000;
+    const float scaleFactor = avgMax > 0 ? maxScale / avgMax : 1;
+    for (float& bin : spectrum) { bin *= scaleFactor; }
+    traceSpectrum.stop();
+
+    AudioCharacteristics c{};
+    c.volumeLeft = volume.left;
+    c.volumeRight = volume.right;
+    c.spectrumMax = maxThisTime;
+    c.spectrum = spectrum;
+    statistics.update(c);
+    previousSpectrumMax = maxThisTime;
+    return c;
+}
+
+std::vector<InstrumentationTrace*> AudioAnalyzer::getInstrumentation() {
+    return {&traceMixDown, &traceFFT, &traceSpectrum};
+}
+
+} // namespace analysis
@@ -2,12 +2,27 @@
 #include "audio/audio.h"
 #ifdef PIXELCLOCK_DESKTOP
 #include "audio/desktop.h"
+#include "audio/replay.h"
 #else
 #include "audio/ESP32.h"
 #endif
 
+/* C++ Standard Library */
+#include <cstdlib>
+#include <cstring>
+
 Audio& AudioSingleton::get() {
 #ifdef PIXELCLOCK_DESKTOP
+    // analyse a file instead of the capture device, e.g. on a machine without one
+    static const char* replayFile = std::getenv("PIXELCLOCK_AUDIO_FILE");
+    if (replayFile) {
+        static const char* pacing = std::getenv("PIXELCLOCK_AUDIO_PACING");
+        static AudioReplay replay(
+            replayFile,
+            pacing && std::strcmp(pacing, "fast") == 0 ? AudioReplay::Pacing::asFastAsPossible
+                                                       : AudioReplay::Pacing::realTime);
+        return replay;
+    }
     static AudioDesktop instance;
 #else
     static AudioESP32 instance;
@@ -0,0 +1,170 @@
+/* Project Scope */
+#include "audio/beatTracker.h"
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cmath>
+
+namespace analysis {
+
+namespace {
+
+constexpr float thresholdRatio = 1.5f;       // onsets must exceed the recent mean flux by this factor...
+constexpr float minimumFlux = 0.5f;          // ...plus this, so noise in near-silence does not trigger them
+constexpr uint32_t minOnsetIntervalMs = 100; // at most 10 onsets a second
+constexpr float minBpm = 60;
+constexpr float maxBpm = 180;
+constexpr float preferredBpm = 120;
+constexpr float phaseCorrection = 0.3f; // fraction of an onset's phase error corrected per onset
+constexpr float phaseCapture = 0.25f;   // onsets further than this from a beat (in beats) do not correct the phase
+
+} // namespace
+
+BeatTracker::BeatTracker(float chunksPerSecond) : chunksPerSecond(chunksPerSecond) {}
+
+void BeatTracker::update(etl::span<const float> spectrum, uint32_t timeMs) {
+    const std::size_t bins = std::min(spectrum.size(), maxBins);
+
+    // spectral flux: summed rise in log magnitude, ignoring falls
+    float flux = 0;
+    for (std::size_t b = 0; b < bins; b++) {
+        const float logMagnitude = std::log1p(std::max(spectrum[b], 0.0f));
+        if (chunkCount > 0) { flux += std::max(logMagnitude - previousLog[b], 0.0f); }
+        previousLog[b] = logMagnitude;
+    }
+
+    envelope[envelopeNext] = flux;
+    envelopeNext = (envelopeNext + 1) % envelopeLength;
+    chunkCount++;
+
+    // the previous chunk was an onset if its flux peaked above the threshold
+    const float threshold = fluxAverage.getMean() * thresholdRatio + minimumFlux;
+    const bool peak = fluxLast > fluxBefore && fluxLast >= flux && fluxLast > threshold;
+    if (peak && (!onsetSeen || lastTimeMs - lastOnsetMs >= minOnsetIntervalMs)) {
+        publish(BeatEvent::Type::onset, lastTimeMs, fluxLast / threshold, phase);
+        onsetSeen = true;
+        lastOnsetMs = lastTimeMs;
+
+        if (bpm > 0 && !phaseLocked) {
+            phase = 0;
+            phaseLocked = true;
+        } else if (bpm > 0) {
+            // how far past (positive) or short of (negative) the nearest beat the onset landed
+            const float error = phase < 0.5f ? phase : phase - 1;
+            if (std::fabs(error) < phaseCapture) { phase -= error * phaseCorrection; }
+        }
+    }
+
+    fluxAverage.push(flux);
+    fluxBefore = fluxLast;
+    fluxLast = flux;
+    lastTimeMs = timeMs;
+
+    if (chunkCount % tempoInterval == 0) { estimateTempo(); }
+
+    if (bpm > 0 && phaseLocked) {
+        phase += bpm / 60 / chunksPerSecond;
+        if (phase >= 1) {
+            phase -= std::floor(phase);
+            publish(BeatEvent::Type::beat, timeMs, confidence, 0);
+        }
+    }
+}
+
+void BeatTracker::estimateTempo() {
+    // wait for a few beats' worth of history
+    const std::size_t n = std::min<std::size_t>(chunkCount, envelopeLength);
+    if (n < envelopeLength / 2) { return; }
+
+    const std::size_t start = (envelopeNext + envelopeLength - n) % envelopeLength;
+    auto at = [&](std::size_t i) { return envelope[(start + i) % envelopeLength]; };
+
+    float mean = 0;
+    for (std::size_t i = 0; i < n; i++) { mean += at(i); }
+    mean /= n;
+
+    auto autocorrelation = [&](std::size_t lag) {
+        float sum = 0;
+        for (std::size_t i = lag; i < n; i++) { sum += (at(i) - mean) * (at(i - lag) - mean); }
+        return sum;
+    };
+
+    const float energy = autocorrelation(0);
+    if (energy <= 1e-6f) {
+        // silence, or a perfectly steady signal
+        bpm = 0;
+        confidence = 0;
+        phaseLocked = false;
+        return;
+    }
+
+    const std::size_t minLag = std::max<std::size_t>(2, std::size_t(chunksPerSecond * 60 / maxBpm));
+    const std::size_t maxLag = std::min<std::size_t>(n / 2, std::size_t(std::ceil(chunksPerSecond * 60 / minBpm)));
+
+    std::size_t bestLag = 0;
+    float bestScore = 0;
+    for (std::size_t lag = minLag; lag <= maxLag; lag++) {
+        // prefer tempos near preferredBpm, down-weighting by 1/e an octave away
+        const float octaves = std::log2(chunksPerSecond * 60 / lag / preferredBpm);
+        const float score = autocorrelation(lag) * std::exp(-octaves * octaves);
+        if (score > bestScore) {
+            bestScore = score;
+            bestLag = lag;
+        }
+    }
+    if (bestLag == 0) {
+        bpm = 0;
+        confidence = 0;
+        phaseLocked = false;
+        return;
+    }
+
+    // refine the peak between whole lags with a parabola through its neighbours
+    const float before = autocorrelation(bestLag - 1);
+    const float at0 = autocorrelation(bestLag);
+    const float after = autocorrelation(bestLag + 1);
+    const float curvature = before - 2 * at0 + after;
+    const float offset = curvature < 0 ? std::clamp(0.5f * (before - after) / curvature, -0.5f, 0.5f) : 0;
+
+    bpm = chunksPerSecond * 60 / (bestLag + offset);
+    confidence = std::clamp(at0 / energy, 0.0f, 1.0f);
+}
+
+void BeatTracker::publish(BeatEvent::Type type, uint32_t timeMs, float strength, float eventPhase) {
+    const BeatEvent event{type, timeMs, strength, bpm, eventPhase};
+    // if the render side is not draining events, drop new ones rather than block the audio side
+    events.write({&event, 1});
+    published++;
+}
+
+void BeatSync::apply(BeatEventQueue& events, FrameContext& frame) {
+    frame.beats = 0;
+    frame.onsets = 0;
+    frame.onsetStrength = 0;
+
+    BeatEvent event;
+    while (events.read({&event, 1}) == 1) {
+        bpm = event.bpm;
+        if (event.type == BeatEvent::Type::beat) {
+            frame.beats++;
+            lastBeatMs = event.timeMs;
+            beatSeen = true;
+        } else {
+            frame.onsets++;
+            frame.onsetStrength = std::max(frame.onsetStrength, event.strength);
+        }
+    }
+
+    // compare by difference, so a beat stamped just after this frame's time reads as phase 0 rather than wrapping
+    const int32_t sinceBeatMs = static_cast<int32_t>(frame.timeMs - lastBeatMs);
+    const float beats = beatSeen && bpm > 0 ? static_cast<float>(std::max(sinceBeatMs, int32_t(0))) * bpm / 60000 : 0;
+    if (beats > lostAfterBeats) {
+        bpm = 0;
+        beatSeen = false;
+    }
+
+    frame.bpm = bpm;
+    frame.beatPhase = beatSeen && bpm > 0 ? beats - std::floor(beats) : 0;
+}
+
+} // namespace analysis
@@ -3,21 +3,19 @@
 /* Project Scope */
 #include "audio/desktop.h"
 #include "FMTWrapper.h"
+#include "allocationTracking.h"
 #include "utility.h"
 
 /* Libraries */
 #include <SFML/Audio.hpp>
-#include <arduinoFFT.h>
-#include <etl/circular_buffer.h>
 
 /* C++ Standard Library */
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
 void AudioDesktop::begin() {
 
-    FFT = std::make_unique<ArduinoFFT<float>>(vReal, vImag, fftSamples, float(fftSampleFreq), weighingFactors);
-
     printing::print("AudioDesktop::begin()!\n");
     std::vector<std::string> availableDevices = sf::SoundRecorder::getAvailableDevices();
 
@@ -39,129 +37,35 @@ void AudioDesktop::begin() {
 
 void AudioDesktop::a2dp_callback(const uint8_t* data, uint32_t length) {
 
+    alloc::ScopeTag tag(alloc::Subsystem::audio);
+
     traceCallbackTotal.start();
+    const uint32_t arrivalUs = clockMicros();
 
     // printing::print(fmt::format("Channels: {}\n", recorder->getChannelCount()));
 
-    int16_t* samples = (int16_t*)data;
-    uint32_t sample_count = length / 2;
-
-    for (uint32_t i = 0; i < sample_count; i++) { audioSamplesBuffer.push(samples[i]); }
+    const int16_t* samples = reinterpret_cast<const int16_t*>(data);
+    const std::size_t sampleCount = length / 2;
+    // if update() has fallen behind, drop whatever does not fit, keeping L/R pairs together
+    const std::size_t writable = std::min(sampleCount, audioSamplesBuffer.free()) & ~std::size_t(1);
+    blockTimestamps.written(writable, arrivalUs);
+    audioSamplesBuffer.write({samples, writable});
 
     traceCallbackTotal.stop();
 }
 
 void AudioDesktop::update() {
 
-    const int samplesToProcess = 2048;
-    while (audioSamplesBuffer.size() >= samplesToProcess) {
-
-        auto& samples = audioSamplesBuffer;
-
-        traceCallbackVolume.start();
-        float vLeftAvg = 0;
-        float vRightAvg = 0;
-        constexpr float fullscaleDiv = 1.0 / 32768;
-
-        // calculate average RMS magnitude for L/R channels
-        for (uint32_t i = 0; i < samplesToProcess; i += 2) {
-            vLeftAvg += samples[i] * samples[i];
-            vRightAvg += samples[i + 1] * samples[i + 1];
-        }
-        int lrSamplesDiv2 = samplesToProcess / 4;
-        vLeftAvg = std::sqrt(vLeftAvg / lrSamplesDiv2) * fullscaleDiv;
-        vRightAvg = std::sqrt(vRightAvg / lrSamplesDiv2) * fullscaleDiv;
-
-        auto mag2db = [](float mag) -> float {
-            if (mag < 1e-3) {
-                return -60.0;
-            } else {
-                return 20 * std::log10(mag);
-            }
-        };
-
-        // convert to dB
-        vLeftAvg = mag2db(vLeftAvg);
-        vRightAvg = mag2db(vRightAvg);
-
-        traceCallbackVolume.stop();
-        traceCallbackFFT.start();
-
-        int sourceIdx = 0;
-        for (uint32_t i = 0; i < fftSamples; i++) {
-
-            if (sourceIdx < samplesToProcess) {
-                // convert stereo samples to mono
-                vReal[i] = static_cast<float>((uint32_t(samples[sourceIdx]) + samples[sourceIdx + 1]) / 2);
-            } else {
-                vReal[i] = 0;
-            }
-            vImag[i] = 0;
-            sourceIdx += 2;
-        }
-
-        FFT->dcRemoval();
-        FFT->windowing(FFTWindow::Hamming, FFTDirection::Forward); /* Weigh data */
-        FFT->compute(FFTDirection::Forward);                       /* Compute FFT */
-        FFT->complexToMagnitude();                                 /* Compute magnitudes */
-
-        traceCallbackFFT.stop();
-        traceCallbackSpectrum.start();
-
-        // Fill the audioSpectrum vector with data.
-        auto spectrum = etl::array<float, audioSpectrumBins>();
-        spectrum.fill(0);
-
-        float prevMax = 0.0;
-        if (!audioCharacteristics.empty()) { prevMax = audioCharacteristics.back().spectrumMax; }
-
-        // Bin FFT results
-        for (int i = 5; i < (fftSamples / 2) - 1; i++) {
-            float freq = static_cast<float>(i * fftFrequencyResolution);
-            int binIdx = static_cast<int>(std::floor(freq / audioSpectrumBinWidth));
-            // int binIdx = i / audioSpectrumBinSize;
-            if (binIdx < spectrum.size()) {
-                float val = vReal[i] / audioSpectrumBinSize;
-
-                // basic noise filter
-                if (val > prevMax * 0.02) { spectrum[binIdx] += val; }
-            }
-        }
-
-        float maxThisTime = *std::max_element(spectrum.begin(), spectrum.end());
-        float avgMax = utility::sum_members(audioCharacteristics, &AudioCharacteristics::spectrumMax) /
-                       audioCharacteristics.size();
-
-        float maxScale = 6000;
-        float scaleFactor = maxScale / avgMax;
-
-        std::transform(
-            spectrum.begin(),
-            spectrum.end(),
-            spectrum.begin(),
-            std::bind(std::multiplies<float>(), std::placeholders::_1, scaleFactor));
-
-        traceCallbackSpectrum.stop();
-
-        AudioCharacteristics c{};
-        c.volumeLeft = vLeftAvg;
-        c.volumeRight = vRightAvg;
-        c.spectrumMax = maxThisTime;
-        c.spectrum = spectrum;
-
-        audioCharacteristics.push(c);
-
-        samples.pop(samplesToProcess);
+    alloc::ScopeTag tag(alloc::Subsystem::audio);
+
+    if (analyzer.process(audioSamplesBuffer, blockTimestamps, audioCharacteristics, clockMillis())) {
+        notifyEvents();
     }
 }
 
 std::vector<InstrumentationTrace*> AudioDesktop::getInstrumentation() {
-    std::vector<InstrumentationTrace*> vec;
-    vec.reserve(4);
+    std::vector<InstrumentationTrace*> vec = analyzer.getInstrumentation();
     vec.push_back(&traceCallbackTotal);
-    vec.push_back(&traceCallbackVolume);
-    vec.push_back(&traceCallbackFFT);
-    vec.push_back(&traceCallbackSpectrum);
     return vec;
 }
 
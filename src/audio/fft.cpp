@@ -0,0 +1,214 @@
+/* Project Scope */
+#include "audio/fft.h"
+#include "fixedPoint.h"
+
+/* Libraries */
+#if __has_include(<esp_dsp.h>)
+#include <esp_dsp.h>
+#define PIXELCLOCK_FFT_ESP_DSP
+#endif
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+RealFFT::RealFFT(std::size_t size)
+    : size(size),
+      window(size, {memory::Placement::bulk, "FFT window"}),
+      twiddleRe(size / 2, {memory::Placement::hot, "FFT twiddles"}),
+      twiddleIm(size / 2, {memory::Placement::hot, "FFT twiddles"}),
+      work(size, {memory::Placement::hot, "FFT work"}) {
+    assert(size >= 4 && (size & (size - 1)) == 0);
+
+    constexpr double twoPi = 6.28318530717958647692;
+    for (std::size_t i = 0; i < size; i++) { window[i] = float(0.54 - 0.46 * std::cos(twoPi * i / (size - 1))); }
+    for (std::size_t k = 0; k < size / 2; k++) {
+        twiddleRe[k] = float(std::cos(twoPi * k / size));
+        twiddleIm[k] = float(-std::sin(twoPi * k / size));
+    }
+
+#ifdef PIXELCLOCK_FFT_ESP_DSP
+    // ESP-DSP keeps its own twiddle table, shared by all instances
+    static bool dspInitialised = false;
+    if (!dspInitialised) { dspInitialised = dsps_fft2r_init_fc32(nullptr, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK; }
+#endif
+}
+
+void RealFFT::magnitudes(etl::span<const float> input, etl::span<float> magnitudes) {
+    assert(input.size() == size && magnitudes.size() == size / 2);
+    const std::size_t half = size / 2;
+
+    float mean = 0;
+    for (float x : input) { mean += x; }
+    mean /= size;
+
+    // pack: z[n] = x[2n] + i*x[2n+1], with DC removal and windowing applied on the way in
+    for (std::size_t i = 0; i < size; i++) { work[i] = (input[i] - mean) * window[i]; }
+
+    transform();
+
+    // split the N/2-point spectrum Z into the N-point spectrum X of the real input, keeping only magnitudes:
+    // X[k] = (Z[k] + conj(Z[N/2-k])) / 2 + W^k * (Z[k] - conj(Z[N/2-k])) / 2i
+    for (std::size_t k = 0; k < half; k++) {
+        const std::size_t m = k == 0 ? 0 : half - k;
+        const float ar = work[2 * k];
+        const float ai = work[2 * k + 1];
+        const float br = work[2 * m];
+        const float bi = work[2 * m + 1];
+
+        const float evenRe = (ar + br) * 0.5f;
+        const float evenIm = (ai - bi) * 0.5f;
+        const float oddRe = (ai + bi) * 0.5f;
+        const float oddIm = (br - ar) * 0.5f;
+
+        const float re = evenRe + twiddleRe[k] * oddRe - twiddleIm[k] * oddIm;
+        const float im = evenIm + twiddleRe[k] * oddIm + twiddleIm[k] * oddRe;
+        magnitudes[k] = std::sqrt(re * re + im * im);
+    }
+}
+
+void RealFFT::transform() {
+    const std::size_t n = size / 2;
+
+#ifdef PIXELCLOCK_FFT_ESP_DSP
+    dsps_fft2r_fc32(work.data(), n);
+    dsps_bit_rev_fc32(work.data(), n);
+#else
+    // bit-reversal permutation
+    for (std::size_t i = 1, j = 0; i < n; i++) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) { j ^= bit; }
+        j ^= bit;
+        if (i < j) {
+            std::swap(work[2 * i], work[2 * j]);
+            std::swap(work[2 * i + 1], work[2 * j + 1]);
+        }
+    }
+
+    // iterative radix-2 butterflies. The twiddle for position j in a group of 'length' is W_N^(j * N / length).
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+        const std::size_t halfLength = length / 2;
+        const std::size_t stride = size / length;
+        for (std::size_t start = 0; start < n; start += length) {
+            for (std::size_t j = 0; j < halfLength; j++) {
+                const float wr = twiddleRe[j * stride];
+                const float wi = twiddleIm[j * stride];
+                float* u = &work[2 * (start + j)];
+                float* v = &work[2 * (start + j + halfLength)];
+                const float tr = v[0] * wr - v[1] * wi;
+                const float ti = v[0] * wi + v[1] * wr;
+                v[0] = u[0] - tr;
+                v[1] = u[1] - ti;
+                u[0] += tr;
+                u[1] += ti;
+            }
+        }
+    }
+#endif
+}
+
+RealFFTQ15::RealFFTQ15(std::size_t size)
+    : size(size),
+      window(size, {memory::Placement::bulk, "FFT window"}),
+      twiddleRe(size / 2, {memory::Placement::hot, "FFT twiddles"}),
+      twiddleIm(size / 2, {memory::Placement::hot, "FFT twiddles"}),
+      work(size, {memory::Placement::hot, "FFT work"}) {
+    assert(size >= 4 && (size & (size - 1)) == 0);
+
+    constexpr double twoPi = 6.28318530717958647692;
+    for (std::size_t i = 0; i < size; i++) {
+        window[i] = fixed::toQ15(0.54 - 0.46 * std::cos(twoPi * i / (size - 1)));
+    }
+    for (std::size_t k = 0; k < size / 2; k++) {
+        twiddleRe[k] = fixed::toQ15(std::cos(twoPi * k / size));
+        twiddleIm[k] = fixed::toQ15(-std::sin(twoPi * k / size));
+    }
+}
+
+void RealFFTQ15::magnitudes(etl::span<const int16_t> input, etl::span<uint32_t> magnitudes) {
+    assert(input.size() == size && magnitudes.size() == size / 2);
+    const std::size_t half = size / 2;
+
+    int32_t sum = 0;
+    for (int16_t x : input) { sum += x; }
+    const int32_t mean = sum / static_cast<int32_t>(size);
+
+    // pack with DC removal and windowing. Without the DC offset a sample can span 17 bits, so it is stored one bit
+    // down, which starts the block exponent at 1.
+    int exponent = 1;
+    int16_t largest = 0;
+    for (std::size_t i = 0; i < size; i++) {
+        int32_t v = ((input[i] - mean) * int32_t(window[i]) + (1 << 15)) >> 16;
+        work[i] = static_cast<int16_t>(v);
+        largest = std::max(largest, fixed::absQ15(work[i]));
+    }
+
+    exponent += transform(largest);
+
+    // split, as in RealFFT::magnitudes. Working with doubled values avoids losing the low bit to the halving.
+    for (std::size_t k = 0; k < half; k++) {
+        const std::size_t m = k == 0 ? 0 : half - k;
+        const int32_t ar = work[2 * k];
+        const int32_t ai = work[2 * k + 1];
+        const int32_t br = work[2 * m];
+        const int32_t bi = work[2 * m + 1];
+
+        const int32_t evenRe = ar + br;
+        const int32_t evenIm = ai - bi;
+        const int32_t oddRe = ai + bi;
+        const int32_t oddIm = br - ar;
+
+        const int64_t re = evenRe + ((int64_t(twiddleRe[k]) * oddRe - int64_t(twiddleIm[k]) * oddIm) >> 15);
+        const int64_t im = evenIm + ((int64_t(twiddleRe[k]) * oddIm + int64_t(twiddleIm[k]) * oddRe) >> 15);
+        const uint32_t doubled = fixed::isqrt(uint64_t(re * re) + uint64_t(im * im));
+        magnitudes[k] = (doubled << exponent) >> 1;
+    }
+}
+
+int RealFFTQ15::transform(int16_t largest) {
+    const std::size_t n = size / 2;
+
+    for (std::size_t i = 1, j = 0; i < n; i++) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) { j ^= bit; }
+        j ^= bit;
+        if (i < j) {
+            std::swap(work[2 * i], work[2 * j]);
+            std::swap(work[2 * i + 1], work[2 * j + 1]);
+        }
+    }
+
+    int totalShift = 0;
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+        // a butterfly can grow a component by up to 1 + sqrt(2), so inputs below 2^13 cannot overflow 16 bits
+        int shift = 0;
+        while ((largest >> shift) >= (1 << 13)) { shift++; }
+        totalShift += shift;
+        largest = 0;
+
+        const std::size_t halfLength = length / 2;
+        const std::size_t stride = size / length;
+        for (std::size_t start = 0; start < n; start += length) {
+            for (std::size_t j = 0; j < halfLength; j++) {
+                const int32_t wr = twiddleRe[j * stride];
+                const int32_t wi = twiddleIm[j * stride];
+                int16_t* u = &work[2 * (start + j)];
+                int16_t* v = &work[2 * (start + j + halfLength)];
+                const int32_t ur = u[0] >> shift;
+                const int32_t ui = u[1] >> shift;
+                const int32_t vr = v[0] >> shift;
+                const int32_t vi = v[1] >> shift;
+                const int32_t tr = (vr * wr - vi * wi + (1 << 14)) >> 15;
+                const int32_t ti = (vr * wi + vi * wr + (1 << 14)) >> 15;
+                u[0] = static_cast<int16_t>(ur + tr);
+                u[1] = static_cast<int16_t>(ui + ti);
+                v[0] = static_cast<int16_t>(ur - tr);
+                v[1] = static_cast<int16_t>(ui - ti);
+                for (int16_t out : {u[0], u[1], v[0], v[1]}) { largest = std::max(largest, fixed::absQ15(out)); }
+            }
+        }
+    }
+    return totalShift;
+}
@@ -0,0 +1,142 @@
+#ifdef PIXELCLOCK_DESKTOP
+
+/* Project Scope */
+#include "audio/replay.h"
+#include "FMTWrapper.h"
+#include "utility.h"
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+uint16_t readU16(const std::vector<uint8_t>& data, std::size_t offset) {
+    return static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8));
+}
+
+uint32_t readU32(const std::vector<uint8_t>& data, std::size_t offset) {
+    return uint32_t(readU16(data, offset)) | (uint32_t(readU16(data, offset + 2)) << 16);
+}
+
+bool hasWavExtension(const std::string& path) {
+    if (path.size() < 4) { return false; }
+    std::string extension = path.substr(path.size() - 4);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".wav";
+}
+
+} // namespace
+
+AudioReplay::AudioReplay(std::string path, Pacing pacing, Clock clock, std::size_t blockFrames)
+    : path(std::move(path)),
+      pacing(pacing),
+      clock(clock),
+      blockSamples(blockFrames * 2) {}
+
+void AudioReplay::begin() {
+    printing::print(fmt::format("AudioReplay::begin(), playing {}\n", path));
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        printing::print(fmt::format("Failed to open audio file {}!\n", path));
+        return;
+    }
+    const std::vector<uint8_t> file{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+    if (hasWavExtension(path)) {
+        if (!loadWav(file)) { printing::print(fmt::format("Unsupported WAV file {}!\n", path)); }
+    } else {
+        // raw interleaved stereo, dropping any incomplete frame at the end
+        samples.resize(file.size() / 4 * 2);
+        for (std::size_t i = 0; i < samples.size(); i++) { samples[i] = static_cast<int16_t>(readU16(file, 2 * i)); }
+    }
+
+    printing::print(fmt::format("Loaded {} frames of audio\n", samples.size() / 2));
+    lastUs = micros();
+}
+
+bool AudioReplay::loadWav(const std::vector<uint8_t>& file) {
+    if (file.size() < 12 || std::string(file.begin(), file.begin() + 4) != "RIFF" ||
+        std::string(file.begin() + 8, file.begin() + 12) != "WAVE") {
+        return false;
+    }
+
+    uint16_t channels = 0;
+    std::size_t offset = 12;
+    while (offset + 8 <= file.size()) {
+        const std::string id(file.begin() + offset, file.begin() + offset + 4);
+        const std::size_t size = std::min<std::size_t>(readU32(file, offset + 4), file.size() - offset - 8);
+        const std::size_t body = offset + 8;
+
+        if (id == "fmt " && size >= 16) {
+            const uint16_t format = readU16(file, body);
+            channels = readU16(file, body + 2);
+            const uint32_t sampleRate = readU32(file, body + 4);
+            const uint16_t bits = readU16(file, body + 14);
+            if (format != 1 || bits != 16 || channels < 1 || channels > 2) { return false; }
+            if (sampleRate != fftSampleFreq) {
+                printing::print(fmt::format(
+                    "Warning: {} is {} Hz, it will be analysed as {} Hz\n", path, sampleRate, fftSampleFreq));
+            }
+        } else if (id == "data" && channels != 0) {
+            const std::size_t frames = size / (2 * channels);
+            samples.resize(frames * 2);
+            for (std::size_t f = 0; f < frames; f++) {
+                const int16_t left = static_cast<int16_t>(readU16(file, body + f * 2 * channels));
+                const int16_t right = static_cast<int16_t>(readU16(file, body + f * 2 * channels + 2 * (channels - 1)));
+                samples[2 * f] = left;
+                samples[2 * f + 1] = right;
+            }
+            return true;
+        }
+        // chunks are padded to an even size
+        offset = body + size + (size & 1);
+    }
+    return false;
+}
+
+void AudioReplay::update() {
+    if (pacing == Pacing::asFastAsPossible) {
+        feed(std::min(blockSamples, samples.size() - position));
+    } else if (!samples.empty()) {
+        const uint32_t nowUs = micros();
+        elapsedUs += nowUs - lastUs;
+        lastUs = nowUs;
+        const uint64_t dueFrames = elapsedUs * fftSampleFreq / 1000000;
+        if (dueFrames * 2 > fedTotal) { feed(static_cast<std::size_t>(dueFrames * 2 - fedTotal)); }
+    }
+
+    AudioDesktop::update();
+}
+
+void AudioReplay::feed(std::size_t count) {
+    while (count > 0 && !samples.empty()) {
+        if (position >= samples.size()) {
+            if (pacing == Pacing::asFastAsPossible) { return; }
+            position = 0;
+        }
+        const std::size_t n = std::min({count, blockSamples, samples.size() - position});
+        // blocks arrive at the time of their last sample
+        fedTotal += n;
+        a2dp_callback(reinterpret_cast<const uint8_t*>(samples.data() + position), static_cast<uint32_t>(n * 2));
+        position += n;
+        count -= n;
+    }
+}
+
+uint32_t AudioReplay::getPositionUs() const { return static_cast<uint32_t>(fedTotal / 2 * 1000000 / fftSampleFreq); }
+
+uint32_t AudioReplay::clockMicros() const {
+    return clock == Clock::file ? getPositionUs() : micros();
+}
+
+uint32_t AudioReplay::clockMillis() const {
+    return clock == Clock::file ? getPositionUs() / 1000 : millis();
+}
+
+#endif
@@ -10,9 +10,21 @@
 namespace canvas {
 
 Canvas::Canvas(int width, int height) : width(width), height(height), length(width * height) {
-    data = std::vector<flm::CRGB>(length, flm::CRGB::Black);
+    data = StorageType(length, flm::CRGB::Black);
 }
 
+Canvas::Canvas(int width, int height, FrameArena& arena)
+    : width(width),
+      height(height),
+      length(width * height),
+      data(length, flm::CRGB::Black, FrameAllocator<flm::CRGB>(arena)) {}
+
+Canvas::Canvas(const Canvas& other, FrameArena& arena)
+    : width(other.width),
+      height(other.height),
+      length(other.length),
+      data(other.data, FrameAllocator<flm::CRGB>(arena)) {}
+
 void Canvas::setXY(int x, int y, flm::CRGB colour) { data[XYToIndex(x, y)] = colour; }
 
 const flm::CRGB& Canvas::getXY(int x, int y) const { return data[XYToIndex(x, y)]; }
@@ -22,7 +34,7 @@ void Canvas::fill(const flm::CRGB& colour) {
 }
 
 std::size_t Canvas::XYToIndex(int x, int y) const {
-    assert(((y * width) + x) < data.size());
+    assert(static_cast<std::size_t>((y * width) + x) < data.size());
     return (y * width) + x;
 }
 
@@ -86,16 +98,30 @@ Canvas blit(const Canvas& background, const Canvas& foreground, int xOffset, int
     return c;
 }
 
+namespace {
+
+void copyRegion(const Canvas& input, int startX, int startY, Canvas& output) {
+    for (int x = 0; x < output.getWidth(); x++) {
+        for (int y = 0; y < output.getHeight(); y++) { output.setXY(x, y, input.getXY(x + startX, y + startY)); }
+    }
+}
+
+} // namespace
+
 Canvas crop(const Canvas& input, int startX, int startY, int width, int height) {
 
     // create new canvas to hold result
     Canvas c(width, height);
 
     // copy cropped region from input
-    for (int x = 0; x < width; x++) {
-        for (int y = 0; y < height; y++) { c.setXY(x, y, input.getXY(x + startX, y + startY)); }
-    }
+    copyRegion(input, startX, startY, c);
+
+    return c;
+}
 
+Canvas crop(const Canvas& input, int startX, int startY, int width, int height, FrameArena& arena) {
+    Canvas c(width, height, arena);
+    copyRegion(input, startX, startY, c);
     return c;
 }
 
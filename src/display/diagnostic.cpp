@@ -3,6 +3,7 @@
 #include "display/canvas.h"
 #include "display/effects/textscroller.h"
 #include "flm_pixeltypes.h"
+#include "frameContext.h"
 
 void displayDiagnostic(Display& display) {
     // Clear display
@@ -38,12 +39,13 @@ void displayDiagnostic(Display& display) {
     }
 
     // Scroll short test
+    FrameClock frameClock;
     c.fill(0);
     display.update(c);
     auto textScrollTest1 =
         RepeatingTextScroller(c, "Hello - Testing!", std::vector<flm::CRGB>{flm::CRGB(0, 0, 255)}, 50, 500, 1);
     while (!textScrollTest1.finished()) {
-        display.update(textScrollTest1.run());
+        display.update(textScrollTest1.run(frameClock.tick(millis())));
         delay(1);
     }
 
@@ -58,7 +60,7 @@ void displayDiagnostic(Display& display) {
         500,
         1);
     while (!textScrollTest.finished()) {
-        display.update(textScrollTest.run());
+        display.update(textScrollTest.run(frameClock.tick(millis())));
         delay(1);
     }
     c.fill(0);
@@ -6,29 +6,25 @@ AudioWaterfall::AudioWaterfall(const canvas::Canvas& size) : _c(size) {}
 
 void AudioWaterfall::reset() { _finished = false; }
 
-canvas::Canvas AudioWaterfall::run() {
+canvas::Canvas AudioWaterfall::run([[maybe_unused]] const FrameContext& frame) {
 
     _c.fill(0);
 
-    AudioSingleton::get().lockMutex();
     const auto& hist = AudioSingleton::get().getAudioCharacteristicsHistory();
-    if (!hist.empty()) {
 
-        int xIdx = _c.getWidth() - 1;
-        for (auto it = hist.rbegin(); it != hist.rend(); ++it) {
-            for (int yIdx = 0; yIdx < _c.getHeight(); yIdx++) {
-                if (yIdx >= it->spectrum.size()) { break; }
-                float val = it->spectrum.at(yIdx);
-                val = val / 8000;
-                flm::CRGB colour = flm::CRGB::Red;
-                colour = colour.scale8(uint8_t(val * 255));
-                _c.setXY(xIdx, _c.getHeight() - 1 - yIdx, colour);
-            }
-            xIdx -= 1;
-            if (xIdx < 0) { break; }
+    // newest spectrum in the rightmost column, a column per window's worth of hops so the scroll speed is fixed
+    AudioCharacteristics ac;
+    for (int column = 0; column < _c.getWidth() && hist.read(column * audioHopsPerWindow, ac); column++) {
+        int xIdx = _c.getWidth() - 1 - column;
+        for (int yIdx = 0; yIdx < _c.getHeight(); yIdx++) {
+            if (yIdx >= ac.spectrum.size()) { break; }
+            float val = ac.spectrum.at(yIdx);
+            val = val / 8000;
+            flm::CRGB colour = flm::CRGB::Red;
+            colour = colour.scale8(uint8_t(val * 255));
+            _c.setXY(xIdx, _c.getHeight() - 1 - yIdx, colour);
         }
     }
-    AudioSingleton::get().releaseMutex();
 
     return _c;
 }
@@ -26,12 +26,16 @@ void BouncingBall::reset() {
     xDir = 1;
     yDir = 1;
     _finished = false;
-    _lastLoopTime = millis();
+    _restartTiming = true;
     _c.fill(flm::CRGB::Black);
 }
 
-canvas::Canvas BouncingBall::run() {
-    uint32_t millisSinceLastRun = millis() - _lastLoopTime;
+canvas::Canvas BouncingBall::run(const FrameContext& frame) {
+    if (_restartTiming) {
+        _lastLoopTime = frame.timeMs;
+        _restartTiming = false;
+    }
+    uint32_t millisSinceLastRun = frame.timeMs - _lastLoopTime;
     if (millisSinceLastRun > _updateInterval) {
         ballx += xDir;
         bally += yDir;
@@ -45,7 +49,7 @@ canvas::Canvas BouncingBall::run() {
         // printing::print(Serial, fmt::format("Ball (x={:.2f}({}), y={:.2f}({}))\n", ballx, pixelx, bally, pixely));
         _c.setXY(pixelx, pixely, _colourGenerator());
 
-        _lastLoopTime = millis();
+        _lastLoopTime = frame.timeMs;
     }
     return _c;
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
 #include <memory>
 #include <string>
 
-canvas::Canvas ClockFace_Simple::run() {
+canvas::Canvas ClockFace_Simple::run([[maybe_unused]] const FrameContext& frame) {
     auto times = timeCallbackFunction();
     std::string timestr = fmt::format("{:2d}:{:02d}", times.hour12, times.minute);
     auto c = canvas::Canvas(17, 5);
@@ -16,6 +16,10 @@ canvas::Canvas ClockFace_Simple::run() {
     return c;
 }
 
+uint32_t ClockFace_Simple::getUpdateInterval([[maybe_unused]] const FrameContext& frame) const {
+    return frameRate::untilNextMinute(timeCallbackFunction().second);
+}
+
 ClockFace_Gravity::ClockFace_Gravity(std::function<ClockFaceTimeStruct(void)> timeCallbackFunction)
     : ClockFace_Base(timeCallbackFunction) {
     gravityEffect = std::make_unique<Gravity>(500, false, Gravity::Direction::down);
@@ -29,7 +33,7 @@ void ClockFace_Gravity::reset() {
     currentState = State::stable;
 }
 
-canvas::Canvas ClockFace_Gravity::run() {
+canvas::Canvas ClockFace_Gravity::run(const FrameContext& frame) {
     auto timeNow = timeCallbackFunction();
 
     switch (currentState) {
@@ -40,11 +44,11 @@ canvas::Canvas ClockFace_Gravity::run() {
             gravityEffect->setInput(_c);
             gravityEffect->setFallOutOfScreen(false);
         } else {
-            _c = clockFace->run();
+            _c = clockFace->run(frame);
         }
         break;
     case State::fallToBottom:
-        _c = gravityEffect->run();
+        _c = gravityEffect->run(frame);
         if (gravityEffect->finished()) {
             currentState = State::fallOut;
             gravityEffect->setFallOutOfScreen(true);
@@ -52,7 +56,7 @@ canvas::Canvas ClockFace_Gravity::run() {
         }
         break;
     case State::fallOut:
-        _c = gravityEffect->run();
+        _c = gravityEffect->run(frame);
         if (gravityEffect->finished()) { currentState = State::stable; }
         break;
     }
@@ -61,6 +65,11 @@ canvas::Canvas ClockFace_Gravity::run() {
     return _c;
 }
 
+uint32_t ClockFace_Gravity::getUpdateInterval(const FrameContext& frame) const {
+    // static between the minutes, animated while the digits fall away
+    return currentState == State::stable ? clockFace->getUpdateInterval(frame) : frameRate::continuous;
+}
+
 ClockFace_GravityFill::ClockFace_GravityFill(
     std::function<ClockFaceTimeStruct(void)> timeCallbackFunction,
     std::unique_ptr<GravityFillTemplate> gravFillTemplate)
@@ -79,14 +88,20 @@ void ClockFace_GravityFill::reset() {
     timePrev = timeCallbackFunction();
 }
 
-canvas::Canvas ClockFace_GravityFill::run() {
+canvas::Canvas ClockFace_GravityFill::run(const FrameContext& frame) {
     auto timeNow = timeCallbackFunction();
 
     if (gravFill->finished()) {
         if (timePrev.minute != timeNow.minute) { reset(); }
     }
-    _c = gravFill->run();
+    _c = gravFill->run(frame);
 
     timePrev = timeNow;
     return _c;
-}
\ No newline at end of file
+}
+
+uint32_t ClockFace_GravityFill::getUpdateInterval([[maybe_unused]] const FrameContext& frame) const {
+    // static once filled, until the minute changes and the fill restarts
+    if (!gravFill->finished()) { return frameRate::continuous; }
+    return frameRate::untilNextMinute(timeCallbackFunction().second);
+}
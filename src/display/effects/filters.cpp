@@ -2,11 +2,12 @@
 #include "display/effects/filters.h"
 
 /* C++ Standard Library */
+#include <algorithm>
 #include <cmath>
 
 using namespace flm;
 
-void HSVTestPattern::apply(canvas::Canvas& c) {
+void HSVTestPattern::apply(canvas::Canvas& c, [[maybe_unused]] const FrameContext& frame) {
     for (int x = 0; x < c.getWidth(); x++) {
         for (int y = 0; y < c.getHeight(); y++) {
             auto colour = CHSV(
@@ -18,16 +19,16 @@ void HSVTestPattern::apply(canvas::Canvas& c) {
     }
 }
 
-void SolidColour::apply(canvas::Canvas& c) {
+void SolidColour::apply(canvas::Canvas& c, [[maybe_unused]] const FrameContext& frame) {
     for (auto& p : c) {
         if (p == CRGB(0)) { continue; }
         p = maintainBrightness ? CRGB(colour).nscale8(p.getAverageLight()) : colour;
     }
 }
 
-void RainbowWave::apply(canvas::Canvas& c) {
+void RainbowWave::apply(canvas::Canvas& c, const FrameContext& frame) {
 
-    uint32_t now = millis();
+    uint32_t now = frame.timeMs;
     uint32_t duration = now - lastUpdateTime;
     lastUpdateTime = now;
 
@@ -51,4 +52,13 @@ void RainbowWave::apply(canvas::Canvas& c) {
             c[index] = CHSV(hue, 255, maintainBrightness ? c[index].getAverageLight() : 255);
         }
     }
-}
\ No newline at end of file
+}
+
+uint32_t RainbowWave::getUpdateInterval() const {
+    if (speed == 0) { return frameRate::idle; }
+    const float intervalMs = 1000 / std::abs(speed);
+    if (intervalMs >= static_cast<float>(frameRate::idle)) { return frameRate::idle; }
+    // frames start on the full-rate grid, so anything under two periods would be rounded up to two and halve the rate
+    if (intervalMs < 2 * frameRate::fullRatePeriod) { return frameRate::continuous; }
+    return static_cast<uint32_t>(intervalMs);
+}
@@ -1,9 +1,11 @@
 /* Project Scope */
 #include "display/effects/gameoflife.h"
 #include "FMTWrapper.h"
+#include "tracing.h"
 #include "utility.h"
 
 /* C++ Standard Library */
+#include <algorithm>
 #include <random>
 
 GameOfLife::GameOfLife(
@@ -19,6 +21,7 @@ GameOfLife::GameOfLife(
       _wrap(wrap) {}
 
 void GameOfLife::reset() {
+    PIXELCLOCK_TRACE_SCOPE("GoL Reset");
     _lastLoopTime = 0;
     _finished = false;
 
@@ -86,7 +89,7 @@ void GameOfLife::reset() {
     _c.fill(flm::CRGB::Black);
 }
 
-canvas::Canvas GameOfLife::run() {
+canvas::Canvas GameOfLife::run(const FrameContext& frame) {
 
     // this shouldn't happen, exit early if it does
     if (!game) {
@@ -95,7 +98,7 @@ canvas::Canvas GameOfLife::run() {
     }
 
     if (game->getAlive()) {
-        if (millis() - _lastLoopTime >= _updateInterval) {
+        if (frame.timeMs - _lastLoopTime >= _updateInterval) {
 
             game->tick();
 
@@ -111,18 +114,18 @@ canvas::Canvas GameOfLife::run() {
                 }
             }
 
-            _lastLoopTime = millis();
+            _lastLoopTime = frame.timeMs;
         }
 
     } else {
         if (!_fadeOnDeath) {
             _finished = true;
         } else {
-            if (millis() - _lastLoopTime >= _fadeInterval) {
+            if (frame.timeMs - _lastLoopTime >= _fadeInterval) {
 
                 // fade all pixels
                 for (auto& p : _c) { p.fadeToBlackBy(10); }
-                _lastLoopTime = millis();
+                _lastLoopTime = frame.timeMs;
             }
             bool empty = true;
             for (const auto& p : _c) {
@@ -137,9 +140,10 @@ canvas::Canvas GameOfLife::run() {
     }
 
     if (_filter) {
-        canvas::Canvas temp(_c);
-        _filter->apply(temp);
-        return temp;
+        // not from the frame arena, as the result leaves run() and may outlive the frame
+        canvas::Canvas filtered(_c);
+        _filter->apply(filtered, frame);
+        return filtered;
     }
 
     return _c;
@@ -147,7 +151,8 @@ canvas::Canvas GameOfLife::run() {
 
 GameOfLifeGame::GameOfLifeGame(GoLRules rules, uint32_t seed) : rules(rules), seed(seed) {
     // zero the data
-    data = std::vector<uint32_t>(rules.width * rules.height, 0);
+    data.assign(rules.width * rules.height, 0);
+    next.assign(rules.width * rules.height, 0);
 
     // setup RNG
     rand.seed(seed);
@@ -166,7 +171,8 @@ void GameOfLifeGame::tick() {
 
     currentTick++;
 
-    auto newData = std::vector<uint32_t>(rules.width * rules.height, 0);
+    auto& newData = next;
+    std::fill(newData.begin(), newData.end(), 0);
 
     int xMin = 0;
     int xMax = rules.width - 1;
@@ -196,7 +202,7 @@ void GameOfLifeGame::tick() {
         }
     }
 
-    data = newData;
+    data.swap(newData);
 
     // count living cells
     uint32_t livingCells = 0;
@@ -237,8 +243,7 @@ void GameOfLifeGame::tick() {
 
 std::size_t GameOfLifeGame::XYToIndex(int x, int y) const { return (y * rules.width) + x; }
 
-int GameOfLifeGame::neighbourCount(
-    int xPos, int yPos, int width, int height, const std::vector<uint32_t>& dataIn, bool wrap) const {
+int GameOfLifeGame::neighbourCount(int xPos, int yPos, int width, int height, const Grid& dataIn, bool wrap) const {
     uint8_t aliveCount = 0;
 
     const int xMin = 0;
@@ -285,7 +290,7 @@ int GameOfLifeGame::neighbourCount(
     return aliveCount;
 }
 
-std::size_t GameOfLifeGame::hashState(const std::vector<uint32_t>& state) const {
+std::size_t GameOfLifeGame::hashState(const Grid& state) const {
     std::size_t seedVal = state.size();
     for (const auto i : state) {
         uint8_t val = 0;
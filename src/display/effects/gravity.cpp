@@ -7,12 +7,16 @@ Gravity::Gravity(uint32_t moveInterval, bool empty, Gravity::Direction direction
       _direction(direction) {}
 
 void Gravity::reset() {
-    _lastMoveTime = millis();
+    _restartTiming = true;
     _finished = false;
 }
 
-canvas::Canvas Gravity::run() {
-    uint32_t timenow = millis();
+canvas::Canvas Gravity::run(const FrameContext& frame) {
+    uint32_t timenow = frame.timeMs;
+    if (_restartTiming) {
+        _lastMoveTime = timenow;
+        _restartTiming = false;
+    }
     if (timenow - _lastMoveTime > _moveInterval) {
         bool anyPixelsMovedThisUpdate = false;
 
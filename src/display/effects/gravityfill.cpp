@@ -1,6 +1,7 @@
 /* Project Scope */
 #include "display/effects/gravityfill.h"
 #include "display/effects/utilities.h"
+#include "frameArena.h"
 
 /* C++ Standard Library */
 #include <memory>
@@ -16,21 +17,21 @@ GravityFill::GravityFill(
     reset();
 }
 
-canvas::Canvas GravityFill::run() {
+canvas::Canvas GravityFill::run(const FrameContext& frame) {
 
     // Start with previous state
     gravityEffect->setInput(_c);
 
     // apply gravity effect
-    _c = gravityEffect->run();
+    _c = gravityEffect->run(frame);
 
     if (gravityEffect->finished()) {
         // if gravity effect could detects no movable pixels, spawn new pixel.
 
         // crop to only top row, this is our spawn region
-        auto topRow = canvas::crop(_c, 0, 0, _c.getWidth(), 1);
+        auto topRow = canvas::crop(_c, 0, 0, _c.getWidth(), 1, FrameArenaSingleton::get());
         randomFill->setInput(topRow);
-        topRow = randomFill->run();
+        topRow = randomFill->run(frame);
         _c = canvas::blit(_c, topRow, 0, 0);
 
         // unblock gravity effect so it can re-try next loop
@@ -53,7 +54,7 @@ void GravityFillTemplate::reset() {
     currentState = State::empty;
 }
 
-canvas::Canvas GravityFillTemplate::run() {
+canvas::Canvas GravityFillTemplate::run(const FrameContext& frame) {
 
     switch (currentState) {
     case State::stable: {
@@ -85,14 +86,14 @@ canvas::Canvas GravityFillTemplate::run() {
         gravityEffect->setInput(_c);
 
         // apply gravity effect
-        _c = gravityEffect->run();
+        _c = gravityEffect->run(frame);
 
         if (gravityEffect->finished()) {
             // if gravity effect could detects no movable pixels, spawn new pixel.
 
             // create list of columns that need new pixels
             auto pixelsPerColumn = [](const canvas::Canvas& c) {
-                std::vector<int> pixelsPerCol;
+                FrameVector<int> pixelsPerCol(FrameAllocator<int>(FrameArenaSingleton::get()));
                 pixelsPerCol.reserve(c.getWidth());
                 for (int x = 0; x < c.getWidth(); x++) {
                     pixelsPerCol.push_back(0);
@@ -103,10 +104,11 @@ canvas::Canvas GravityFillTemplate::run() {
                 return pixelsPerCol;
             };
 
-            std::vector<int> pixelsPerColTarget = pixelsPerColumn(templateCanvas);
-            std::vector<int> pixelsPerColCurrent = pixelsPerColumn(_c);
+            FrameVector<int> pixelsPerColTarget = pixelsPerColumn(templateCanvas);
+            FrameVector<int> pixelsPerColCurrent = pixelsPerColumn(_c);
 
-            std::vector<int> colsNeedingNewPixel;
+            FrameVector<int> colsNeedingNewPixel(FrameAllocator<int>(FrameArenaSingleton::get()));
+            colsNeedingNewPixel.reserve(pixelsPerColTarget.size());
             for (int i = 0; i < pixelsPerColTarget.size(); i++) {
                 if (pixelsPerColCurrent[i] < pixelsPerColTarget[i]) { colsNeedingNewPixel.push_back(i); }
             }
@@ -17,8 +17,8 @@ RandomFill::RandomFill(const canvas::Canvas& size, uint32_t fillInterval, colour
     rand.seed(0);
 }
 
-canvas::Canvas RandomFill::run() {
-    uint32_t timeNow = millis();
+canvas::Canvas RandomFill::run(const FrameContext& frame) {
+    const uint32_t timeNow = frame.timeMs;
 
     std::uniform_int_distribution<int> horDist(0, _c.getWidth() - 1);
     std::uniform_int_distribution<int> vertDist(0, _c.getHeight() - 1);
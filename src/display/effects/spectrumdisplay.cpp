@@ -2,9 +2,11 @@
 #include "display/effects/spectrumdisplay.h"
 #include "audio/audio.h"
 #include "display/effects/utilities.h"
+#include "frameArena.h"
 
 /* C++ Standard Library */
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -15,28 +17,23 @@ SpectrumDisplay::SpectrumDisplay(const canvas::Canvas& size) : _c(size) {
 
 void SpectrumDisplay::reset() { _finished = false; }
 
-canvas::Canvas SpectrumDisplay::run() {
-    AudioSingleton::get().lockMutex();
-
-    // average this many spectrums max
-    const std::size_t maxSamplesToAvg = 5;
-    std::vector<float> totals;
+canvas::Canvas SpectrumDisplay::run([[maybe_unused]] const FrameContext& frame) {
+    // average this many spectrums max, the last five windows' worth
+    const std::size_t maxSamplesToAvg = 5 * audioHopsPerWindow;
+    FrameVector<float> totals(FrameAllocator<float>(FrameArenaSingleton::get()));
     const auto& hist = AudioSingleton::get().getAudioCharacteristicsHistory();
-    if (!hist.empty()) {
-        totals = std::vector<float>(hist.back().spectrum.size(), 0);
-
-        // limit averages to maximum and available
-        const std::size_t samplesToAvg = std::min(maxSamplesToAvg, hist.size());
 
-        // iterate in reverse order so we always average N latest
-        int idx = 0;
-        for (auto it = hist.rbegin(); it != hist.rend(); ++it) {
-            // add values for this spectrum to total sum
-            for (int i = 0; i < it->spectrum.size(); i++) { totals[i] += it->spectrum[i]; }
-            idx++;
-            if (idx == samplesToAvg) { break; }
-        }
+    // average the N latest spectrums, or as many as are available
+    std::size_t samplesToAvg = 0;
+    AudioCharacteristics ac;
+    while (samplesToAvg < maxSamplesToAvg && hist.read(samplesToAvg, ac)) {
+        if (totals.empty()) { totals.assign(ac.spectrum.size(), 0); }
+        // add values for this spectrum to total sum
+        for (int i = 0; i < ac.spectrum.size(); i++) { totals[i] += ac.spectrum[i]; }
+        samplesToAvg++;
+    }
 
+    if (samplesToAvg > 0) {
         // divide summed values by N samples
         std::transform(
             totals.begin(),
@@ -44,7 +41,6 @@ canvas::Canvas SpectrumDisplay::run() {
             totals.begin(),
             std::bind(std::multiplies<float>(), std::placeholders::_1, 1.0f / samplesToAvg));
     }
-    AudioSingleton::get().releaseMutex();
 
     int vertMax = _c.getHeight();
     if (!totals.empty()) {
@@ -21,29 +21,29 @@ TextScroller::TextScroller(
       stepDelay(stepDelay),
       timeToHoldAtEnd(timeToHoldAtEnd),
       charSpacing(characterSpacing) {
-    lastUpdateTime = millis();
+    lastUpdateTime = 0;
     currentOffset = 0;
     setTargetOffset(0);
 }
 
-canvas::Canvas TextScroller::run() {
+canvas::Canvas TextScroller::run(const FrameContext& frame) {
     if (currentOffset == targetOffset) {
         if (arrivedAtEndTime == 0) {
-            arrivedAtEndTime = millis();
+            arrivedAtEndTime = frame.timeMs;
         } else {
-            if (millis() - arrivedAtEndTime > timeToHoldAtEnd) {
+            if (frame.timeMs - arrivedAtEndTime > timeToHoldAtEnd) {
                 _finished = true;
                 arrivedAtEndTime = 0;
             }
         }
     } else {
-        if (millis() - lastUpdateTime >= stepDelay) {
+        if (frame.timeMs - lastUpdateTime >= stepDelay) {
             if (targetOffset > currentOffset) {
                 currentOffset += 1;
             } else if (targetOffset < currentOffset) {
                 currentOffset -= 1;
             }
-            lastUpdateTime = millis();
+            lastUpdateTime = frame.timeMs;
         }
     }
     _c.fill(flm::CRGB::Black);
@@ -84,8 +84,8 @@ RepeatingTextScroller::RepeatingTextScroller(
     TextScroller::setTargetOffset(-1);
 }
 
-canvas::Canvas RepeatingTextScroller::run() {
-    auto c = TextScroller::run();
+canvas::Canvas RepeatingTextScroller::run(const FrameContext& frame) {
+    auto c = TextScroller::run(frame);
     bool scrollerFinished = TextScroller::finished();
     if (scrollerFinished) {
         if (forward) {
@@ -1,6 +1,5 @@
 /* Project Scope */
 #include "display/effects/volumedisplay.h"
-#include "EMA.h"
 #include "FMTWrapper.h"
 #include "audio/audio.h"
 #include "display/display.h"
@@ -15,22 +14,17 @@ VolumeDisplay::VolumeDisplay(const canvas::Canvas& size) : _c(size) {
 
 void VolumeDisplay::reset() { _finished = false; }
 
-canvas::Canvas VolumeDisplay::run() {
+canvas::Canvas VolumeDisplay::run([[maybe_unused]] const FrameContext& frame) {
 
-    auto& audioHist = AudioSingleton::get().getAudioCharacteristicsHistory();
+    const auto& audioHist = AudioSingleton::get().getAudioCharacteristicsHistory();
 
     float vLeft = -60;
     float vRight = -60;
 
     if (!audioHist.empty()) {
-        utility::EMA leftAvg(0.8f);
-        utility::EMA rightAvg(0.8f);
-        for (const auto& v : audioHist) {
-            leftAvg.update(v.volumeLeft);
-            rightAvg.update(v.volumeRight);
-        }
-        vLeft = leftAvg.getValue();
-        vRight = rightAvg.getValue();
+        const AudioCharacteristics latest = audioHist.latest();
+        vLeft = latest.volumeLeftSmoothed;
+        vRight = latest.volumeRightSmoothed;
     }
     // printing::print(Serial, fmt::format("Volume: L={:.1f} R={:.1f}\n", vLeft, vRight));
 
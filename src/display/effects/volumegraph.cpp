@@ -1,40 +1,43 @@
 /* Project Scope */
 #include "display/effects/volumegraph.h"
-#include "EMA.h"
 #include "FMTWrapper.h"
 #include "audio/audio.h"
 #include "display/display.h"
 #include "display/effects/utilities.h"
 #include "utility.h"
 
+/* C++ Standard Library */
+#include <algorithm>
+
 VolumeGraph::VolumeGraph(const canvas::Canvas& size) : _c(size) {}
 
 void VolumeGraph::reset() { _finished = false; }
 
-canvas::Canvas VolumeGraph::run() {
+canvas::Canvas VolumeGraph::run([[maybe_unused]] const FrameContext& frame) {
 
     _c.fill(0);
-    auto& audioHist = AudioSingleton::get().getAudioCharacteristicsHistory();
+    const auto& audioHist = AudioSingleton::get().getAudioCharacteristicsHistory();
 
     float volMin = 0;
     float volMax = -60;
-    for (auto it = audioHist.rbegin(); it != audioHist.rend(); ++it) {
-        float vol = (it->volumeLeft + it->volumeRight) / 2;
-        if (vol > volMax) { volMax = vol; }
-        if (vol < volMin) { volMin = vol; }
+    if (!audioHist.empty()) {
+        const AudioCharacteristics latest = audioHist.latest();
+        volMin = std::min(volMin, latest.volumeMin);
+        volMax = std::max(volMax, latest.volumeMax);
     }
 
-    int xIdx = _c.getWidth() - 1;
-    for (auto it = audioHist.rbegin(); it != audioHist.rend(); ++it) {
-        float vol = (it->volumeLeft + it->volumeRight) / 2;
+    AudioCharacteristics ac;
+
+    // newest volume in the rightmost column, a column per window's worth of hops so the scroll speed is fixed
+    for (int column = 0; column < _c.getWidth() && audioHist.read(column * audioHopsPerWindow, ac); column++) {
+        int xIdx = _c.getWidth() - 1 - column;
+        float vol = (ac.volumeLeft + ac.volumeRight) / 2;
         float barHeight = calculateBarHeight(vol, volMin * 0.9f, volMax * 0.9f, static_cast<float>(_c.getHeight()));
         for (int yIdx = 0; yIdx < _c.getHeight(); yIdx++) {
             flm::CRGB colour = flm::CRGB::Black;
             if (yIdx <= barHeight) { colour = flm::CRGB::Blue; }
             _c.setXY(xIdx, _c.getHeight() - 1 - yIdx, colour);
         }
-        xIdx -= 1;
-        if (xIdx < 0) { break; }
     }
 
     return _c;
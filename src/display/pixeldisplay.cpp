@@ -88,6 +88,12 @@ void PixelDisplay::update(const canvas::Canvas& canvas) {
     traceUpdateTotal.stop();
 }
 
+void PixelDisplay::update(const canvas::Canvas& canvas, const FrameContext& frame) {
+    update(canvas);
+    // the LEDs have latched the frame, so this is the age of its audio when it became visible
+    if (leds && frame.audioCaptureUs != 0) { traceAudioLatency.update(micros() - frame.audioCaptureUs); }
+}
+
 uint32_t PixelDisplay::XYToIndex(uint8_t x, uint8_t y) const {
     uint16_t i;
 
@@ -123,8 +129,9 @@ uint32_t PixelDisplay::XYToIndex(uint8_t x, uint8_t y) const {
 
 std::vector<InstrumentationTrace*> PixelDisplay::getInstrumentation() {
     std::vector<InstrumentationTrace*> vec;
-    vec.reserve(2);
+    vec.reserve(3);
     vec.push_back(&traceUpdateTotal);
     vec.push_back(&traceUpdateLEDWrite);
+    vec.push_back(&traceAudioLatency);
     return vec;
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+/* Project Scope */
+#include "display/transitions.h"
+
+namespace transitions {
+
+namespace {
+
+// Inputs may be smaller than the output (e.g., an empty canvas from a mode with nothing to show), so reads outside
+// an input are treated as black.
+inline flm::CRGB sample(const canvas::Canvas& c, int x, int y) {
+    if (x < c.getWidth() && y < c.getHeight()) { return c.getXY(x, y); }
+    return flm::CRGB::Black;
+}
+
+} // namespace
+
+const char* typeName(Type type) {
+    switch (type) {
+    case Type::slide:
+        return "Slide";
+    case Type::crossfade:
+        return "Crossfade";
+    case Type::wipe:
+        return "Wipe";
+    case Type::dissolve:
+        return "Dissolve";
+    }
+    return "Unknown";
+}
+
+Progress easedProgress(float fraction, const EasingTable& table) {
+    if (fraction <= 0) { return table.front(); }
+    if (fraction >= 1) { return table.back(); }
+    return table[static_cast<std::size_t>(fraction * 255)];
+}
+
+void slide(
+    const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, int direction, canvas::Canvas& out) {
+    const int width = out.getWidth();
+    const int shift = (progress * width + 127) / 255;
+
+    for (int x = 0; x < width; x++) {
+        // column of the combined (from + to) strip that lands at x
+        int source = direction >= 0 ? x + shift : x - shift;
+        const canvas::Canvas* src = &from;
+        if (source >= width) {
+            source -= width;
+            src = &to;
+        } else if (source < 0) {
+            source += width;
+            src = &to;
+        }
+        for (int y = 0; y < out.getHeight(); y++) { out.setXY(x, y, sample(*src, source, y)); }
+    }
+}
+
+void crossfade(const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, canvas::Canvas& out) {
+    // lerp8 stops one step short of the target, so finish exactly on the incoming canvas
+    if (progress == 255) {
+        for (int x = 0; x < out.getWidth(); x++) {
+            for (int y = 0; y < out.getHeight(); y++) { out.setXY(x, y, sample(to, x, y)); }
+        }
+        return;
+    }
+    for (int x = 0; x < out.getWidth(); x++) {
+        for (int y = 0; y < out.getHeight(); y++) {
+            out.setXY(x, y, sample(from, x, y).lerp8(sample(to, x, y), progress));
+        }
+    }
+}
+
+void wipe(
+    const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, int direction, canvas::Canvas& out) {
+    const int width = out.getWidth();
+    const int edge = (progress * width + 127) / 255;
+
+    for (int x = 0; x < width; x++) {
+        bool covered = direction >= 0 ? x >= width - edge : x < edge;
+        const canvas::Canvas& src = covered ? to : from;
+        for (int y = 0; y < out.getHeight(); y++) { out.setXY(x, y, sample(src, x, y)); }
+    }
+}
+
+void dissolve(const canvas::Canvas& from, const canvas::Canvas& to, Progress progress, canvas::Canvas& out) {
+    for (int x = 0; x < out.getWidth(); x++) {
+        for (int y = 0; y < out.getHeight(); y++) {
+            // fixed pseudo-random threshold per pixel, so pixels switch over one at a time in a stable order
+            uint32_t h = static_cast<uint32_t>(out.XYToIndex(x, y)) * 2654435761u;
+            uint8_t threshold = static_cast<uint8_t>(h >> 24);
+            bool switched = progress > threshold || progress == 255;
+            out.setXY(x, y, switched ? sample(to, x, y) : sample(from, x, y));
+        }
+    }
+}
+
+void compose(
+    Type type,
+    const canvas::Canvas& from,
+    const canvas::Canvas& to,
+    Progress progress,
+    int direction,
+    canvas::Canvas& out) {
+    switch (type) {
+    case Type::slide:
+        slide(from, to, progress, direction, out);
+        break;
+    case Type::crossfade:
+        crossfade(from, to, progress, out);
+        break;
+    case Type::wipe:
+        wipe(from, to, progress, direction, out);
+        break;
+    case Type::dissolve:
+        dissolve(from, to, progress, out);
+        break;
+    }
+}
+
+void Transition::start(const canvas::Canvas& outgoing, Type type, uint32_t durationMs, int direction) {
+    snapshot = outgoing;
+    this->type = type;
+    this->durationMs = durationMs;
+    this->direction = direction;
+    elapsedMs = 0;
+    running = true;
+}
+
+const canvas::Canvas& Transition::apply(const canvas::Canvas& incoming, const FrameContext& frame) {
+    if (!running) { return incoming; }
+
+    elapsedMs += frame.deltaMs;
+    if (elapsedMs >= durationMs) {
+        running = false;
+        return incoming;
+    }
+
+    float fraction = static_cast<float>(elapsedMs) / durationMs;
+    compose(type, snapshot, incoming, easedProgress(fraction), direction, output);
+    return output;
+}
+
+} // namespace transitions
@@ -0,0 +1,34 @@
+/* Project Scope */
+#include "frameArena.h"
+#include "memoryPlacement.h"
+
+FrameArena::FrameArena(std::size_t capacity) : capacity(capacity) {
+    // Every frame's scratch data comes from here, so keep it in fast internal RAM
+    buffer = static_cast<uint8_t*>(memory::allocate(capacity, memory::Placement::hot, "Frame arena"));
+}
+
+FrameArena::~FrameArena() { memory::release(buffer); }
+
+void* FrameArena::allocate(std::size_t bytes, std::size_t alignment) {
+    if (!buffer) { return nullptr; }
+
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+    uintptr_t start = (base + used + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    std::size_t end = (start - base) + bytes;
+    if (end > capacity) { return nullptr; }
+
+    used = end;
+    if (used > highWaterMark) { highWaterMark = used; }
+    return reinterpret_cast<void*>(start);
+}
+
+void FrameArena::reset() {
+    traceBytesUsed.update(static_cast<uint32_t>(used));
+    used = 0;
+}
+
+FrameArena& FrameArenaSingleton::get() {
+    constexpr std::size_t frameArenaSize = 4096;
+    static FrameArena instance(frameArenaSize);
+    return instance;
+}
@@ -0,0 +1,157 @@
+/* Project Scope */
+#include "frameScheduler.h"
+
+/* Arduino Core */
+#include <Arduino.h>
+
+/* Libraries */
+#ifndef PIXELCLOCK_DESKTOP
+#include <esp_timer.h>
+#endif
+
+/* C++ Standard Library */
+#ifdef PIXELCLOCK_DESKTOP
+#include <chrono>
+#endif
+
+namespace {
+
+// Wrap-safe comparison of micros() values
+bool reached(uint32_t nowUs, uint32_t deadlineUs) { return int32_t(nowUs - deadlineUs) >= 0; }
+
+} // namespace
+
+FrameScheduler::FrameScheduler(uint32_t periodUs, OverrunPolicy policy, uint8_t maxCatchUp)
+    : periodUs(periodUs),
+      policy(policy),
+      maxCatchUp(maxCatchUp) {}
+
+FrameScheduler::~FrameScheduler() {
+#ifndef PIXELCLOCK_DESKTOP
+    if (wakeTimer) {
+        esp_timer_stop(static_cast<esp_timer_handle_t>(wakeTimer));
+        esp_timer_delete(static_cast<esp_timer_handle_t>(wakeTimer));
+    }
+#endif
+}
+
+uint32_t FrameScheduler::schedule(uint32_t nowUs, uint32_t idleUs) {
+    if (!started) {
+        started = true;
+        nextDeadlineUs = nowUs + periodUs;
+        lastStartUs = nowUs;
+        return nowUs;
+    }
+
+    if (holding && reached(nowUs, holdUntilUs)) { holding = false; }
+
+    // nothing needs drawing until 'idleUs' after the previous frame, so move on to the first deadline after that
+    if (idleUs > periodUs && !holding) {
+        const uint32_t wantedUs = lastStartUs + idleUs;
+        if (int32_t(wantedUs - nextDeadlineUs) > 0) {
+            nextDeadlineUs += (wantedUs - nextDeadlineUs + periodUs - 1) / periodUs * periodUs;
+        }
+    }
+
+    if (!reached(nowUs, nextDeadlineUs)) {
+        lastStartUs = nextDeadlineUs;
+        nextDeadlineUs += periodUs;
+        return lastStartUs;
+    }
+
+    // overrun: 'behind' more deadlines have passed after this frame's
+    const uint32_t lateUs = nowUs - nextDeadlineUs;
+    const uint32_t behind = lateUs / periodUs;
+    overruns++;
+    traceLateness.update(lateUs);
+
+    uint32_t drop = behind;
+    if (policy == OverrunPolicy::catchUp) { drop = behind > maxCatchUp ? behind - maxCatchUp : 0; }
+    skipped += drop;
+    nextDeadlineUs += (drop + 1) * periodUs;
+    lastStartUs = nowUs;
+    return nowUs;
+}
+
+void FrameScheduler::waitForNextFrame(uint32_t idleUs) {
+    const uint32_t due = schedule(micros(), idleUs);
+    if (!reached(micros(), due)) { sleepUntil(due); }
+
+    if (wakeRequested.exchange(false, std::memory_order_acquire)) {
+        // start the frame now, on a new grid from here
+        const uint32_t nowUs = micros();
+        lastStartUs = nowUs;
+        nextDeadlineUs = nowUs + periodUs;
+        if (holdRequested.exchange(false, std::memory_order_relaxed)) {
+            holdUntilUs = nowUs + holdUs;
+            holding = true;
+        }
+    }
+}
+
+void FrameScheduler::wake(bool hold) {
+    if (hold) { holdRequested.store(true, std::memory_order_relaxed); }
+    wakeRequested.store(true, std::memory_order_release);
+#ifdef PIXELCLOCK_DESKTOP
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    wakeCondition.notify_one();
+#else
+    if (void* task = waitingTask.load(std::memory_order_relaxed)) { xTaskNotifyGive(static_cast<TaskHandle_t>(task)); }
+#endif
+}
+
+// Called from interrupt handlers, which must not run from flash
+void IRAM_ATTR FrameScheduler::wakeFromISR(bool hold) {
+#ifdef PIXELCLOCK_DESKTOP
+    wake(hold);
+#else
+    if (hold) { holdRequested.store(true, std::memory_order_relaxed); }
+    wakeRequested.store(true, std::memory_order_release);
+    if (void* task = waitingTask.load(std::memory_order_relaxed)) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(static_cast<TaskHandle_t>(task), &higherPriorityTaskWoken);
+        if (higherPriorityTaskWoken) { portYIELD_FROM_ISR(); }
+    }
+#endif
+}
+
+void FrameScheduler::sleepUntil(uint32_t deadlineUs) {
+    traceSleep.start();
+
+#ifdef PIXELCLOCK_DESKTOP
+    const auto remaining = std::chrono::microseconds(int32_t(deadlineUs - micros()));
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeCondition.wait_until(lock, std::chrono::steady_clock::now() + remaining, [this]() {
+        return wakeRequested.load(std::memory_order_acquire);
+    });
+#else
+    if (!wakeTimer) {
+        TaskHandle_t task = xTaskGetCurrentTaskHandle();
+        esp_timer_create_args_t args{};
+        args.callback = [](void* t) { xTaskNotifyGive(static_cast<TaskHandle_t>(t)); };
+        args.arg = task;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "FrameScheduler";
+        esp_timer_handle_t timer = nullptr;
+        if (esp_timer_create(&args, &timer) == ESP_OK) { wakeTimer = timer; }
+        waitingTask.store(task, std::memory_order_relaxed);
+    }
+
+    // clear any stale notification first; a wake() after this is still seen through the flag or the notification
+    ulTaskNotifyTake(pdTRUE, 0);
+    while (!reached(micros(), deadlineUs) && !wakeRequested.load(std::memory_order_acquire)) {
+        const int32_t remaining = int32_t(deadlineUs - micros());
+        if (wakeTimer && remaining > 0) {
+            // block until the timer fires or wake() is called. The timeout is only a safety net.
+            esp_timer_stop(static_cast<esp_timer_handle_t>(wakeTimer));
+            esp_timer_start_once(static_cast<esp_timer_handle_t>(wakeTimer), remaining);
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(remaining / 1000 + 10));
+        } else {
+            yield();
+        }
+    }
+    if (wakeTimer) { esp_timer_stop(static_cast<esp_timer_handle_t>(wakeTimer)); }
+#endif
+
+    traceSleep.stop();
+}
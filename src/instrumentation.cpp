@@ -1,26 +1,69 @@
 /* Project Scope */
 #include "instrumentation.h"
 #include "FMTWrapper.h"
+#include "timeline.h"
 
 /* Arduino Core */
 #include <Arduino.h>
 
 /* C++ Standard Library */
+#include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <string>
 
-InstrumentationTrace::InstrumentationTrace(std::string name) : name(name) { reset(); }
+std::size_t LogHistogram::bucketOf(uint32_t value) {
+    if (value < subBuckets) { return value; }
+    // position of the top bit, and the subBucketBits below it
+    uint8_t top = 31;
+    while (!(value & (1u << top))) { top--; }
+    const uint32_t sub = (value >> (top - subBucketBits)) & (subBuckets - 1);
+    return subBuckets + (top - subBucketBits) * subBuckets + sub;
+}
+
+uint32_t LogHistogram::bucketValue(std::size_t bucket) {
+    if (bucket < subBuckets) { return static_cast<uint32_t>(bucket); }
+    const uint8_t top = static_cast<uint8_t>((bucket - subBuckets) / subBuckets + subBucketBits);
+    const uint32_t sub = static_cast<uint32_t>((bucket - subBuckets) % subBuckets);
+    const uint8_t shift = top - subBucketBits;
+    const uint64_t low = (uint64_t(subBuckets + sub)) << shift;
+    const uint64_t width = uint64_t(1) << shift;
+    return static_cast<uint32_t>(low + (width - 1) / 2);
+}
+
+uint32_t LogHistogram::percentile(float fraction) const {
+    uint64_t total = 0;
+    for (auto c : counts) { total += c; }
+    if (total == 0) { return 0; }
+
+    // nearest rank, counting from 1
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(double(fraction) * total)));
+    uint64_t seen = 0;
+    for (std::size_t b = 0; b < bucketCount; b++) {
+        seen += counts[b];
+        if (seen >= rank) { return bucketValue(b); }
+    }
+    return bucketValue(bucketCount - 1);
+}
+
+InstrumentationTrace::InstrumentationTrace(std::string name, Detail detail) : name(name) {
+    if (detail == Detail::percentiles) { histogram = std::make_unique<LogHistogram>(); }
+    reset();
+}
 
-void InstrumentationTrace::start() { started = micros(); }
+void InstrumentationTrace::start() {
+    tracing::timelineBegin(name.c_str());
+    started = micros();
+}
 
 void InstrumentationTrace::stop() {
     uint32_t duration = micros() - started;
     update(duration);
+    tracing::timelineEnd(name.c_str());
 }
 
 void InstrumentationTrace::update(uint32_t value) {
     sum += value;
-    sumSamples++;
     hits++;
     if (empty) {
         min = value;
@@ -30,17 +73,21 @@ void InstrumentationTrace::update(uint32_t value) {
         if (value < min) { min = value; }
         if (value > max) { max = value; }
     }
-    avg = static_cast<uint32_t>(sum / sumSamples);
+    if (histogram) { histogram->add(value); }
 }
 
 void InstrumentationTrace::reset() {
     min = 0;
     max = 0;
-    avg = 0;
     sum = 0;
-    sumSamples = 0;
     hits = 0;
     empty = true;
+    if (histogram) { histogram->reset(); }
+}
+
+uint32_t InstrumentationTrace::getPercentile(float fraction) const {
+    if (!histogram || empty) { return 0; }
+    return std::clamp(histogram->percentile(fraction), min, max);
 }
 
 std::string formatInstrumentationTrace(std::string name, const InstrumentationTrace& trace) {
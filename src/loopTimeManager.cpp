@@ -1,113 +1,245 @@
 /* Project Scope */
 #include "loopTimeManager.h"
 #include "FMTWrapper.h"
+#include "allocationTracking.h"
+#include "frameArena.h"
+#include "memoryPlacement.h"
+#include "telemetry.h"
+#include "tracing.h"
 #include "utility.h"
 
 /* Arduino Core */
 #include <Arduino.h>
 
+/* C++ Standard Library */
+#include <algorithm>
+#include <string>
+
 using namespace printing;
 
-LoopTimeManager::LoopTimeManager(uint32_t desiredLoopDuration, uint32_t statReportInterval)
-    : desiredLoopDuration(desiredLoopDuration),
+LoopTimeManager::LoopTimeManager(
+    uint32_t desiredLoopDuration,
+    uint32_t statReportInterval,
+    FrameScheduler::OverrunPolicy overrunPolicy)
+    : scheduler(desiredLoopDuration * 1000, overrunPolicy),
       statReportInterval(statReportInterval) {}
 
-void LoopTimeManager::idle() {
+// Out of line, so it can be placed in IRAM with the interrupt handlers that call it
+void IRAM_ATTR LoopTimeManager::wakeOnInputFromISR() { scheduler.wakeFromISR(true); }
+
+void LoopTimeManager::idle(uint32_t updateInterval) {
+    // Everything outside idle() is rendering
+    renderTask.workStop();
+    if (!renderTask.attached()) { renderTask.attachCurrentTask(); }
+
+    // The frame is complete, so scratch memory used while rendering it can be released
+    FrameArenaSingleton::get().reset();
+    alloc::AllocationMonitorSingleton::get().endFrame();
+
     // Manage loop timing
 
-    if (millis() - lastStatReportTime > statReportInterval) {
+#ifdef PIXELCLOCK_BINARY_TELEMETRY
+    if (millis() - lastTelemetryTime >= telemetryInterval) { publishTelemetry(); }
+#else
+    if (millis() - lastStatReportTime > statReportInterval) { printReport(); }
+#endif
+
+    loop.stop();
+    // sleep until the next frame is due, yielding at least once
+    yield();
+    scheduler.waitForNextFrame(std::min(updateInterval, maxIdleInterval) * 1000);
+    loop.start();
+    renderTask.workStart();
+}
 
-        printout.start();
+void LoopTimeManager::printReport() {
+    printout.start();
 
-        constexpr int nameWidth = 30;
-        constexpr int fieldWidth = 15;
+    constexpr int nameWidth = 30;
+    constexpr int fieldWidth = 15;
+    constexpr int percentileWidth = 10;
 
-        // print timing stats
-        printCentred("Timing Statistics", headingWidth);
-        print(fmt::format("Time Now: {} ms\n", millis()));
+    // print timing stats
+    printCentred("Timing Statistics", headingWidth);
+    print(fmt::format("Time Now: {} ms\n", millis()));
 
+    auto printRow = [&](const auto&... fields) {
         print(fmt::format(
-            "{2:<{0}}{3:<{1}}{4:<{1}}{5:<{1}}{6:<{1}}\n",
+            "{3:<{0}}{4:<{1}}{5:<{1}}{6:<{1}}{7:<{1}}{8:<{2}}{9:<{2}}{10:<{2}}{11:<{2}}\n",
             nameWidth,
             fieldWidth,
-            "",
-            "Hits",
-            "Min (us)",
-            "Max (us)",
-            "Avg (us)"));
-
-        auto printTrace = [&](const InstrumentationTrace& trace) {
-            print(fmt::format(
-                "{2:<{0}}{3:<{1}}{4:<{1}}{5:<{1}}{6:<{1}}\n",
-                nameWidth,
-                fieldWidth,
-                trace.getName(),
-                trace.getHits(),
-                trace.getMin(),
-                trace.getMax(),
-                trace.getAvg()));
-        };
+            percentileWidth,
+            fields...));
+    };
 
-        printTrace(loop);
-        loop.reset();
+    printRow("", "Hits", "Min (us)", "Max (us)", "Avg (us)", "P50", "P90", "P99", "P99.9");
 
-        for (auto& c : callbacks) {
-            auto traces = c();
-            for (auto trace : traces) {
-                printTrace(*trace);
-                trace->reset();
-            }
+    auto printTrace = [&](const InstrumentationTrace& trace) {
+        // percentiles are only shown for traces that keep a histogram
+        auto percentile = [&](float fraction) {
+            return trace.hasPercentiles() ? std::to_string(trace.getPercentile(fraction)) : std::string("-");
+        };
+        printRow(
+            trace.getName(),
+            trace.getHits(),
+            trace.getMin(),
+            trace.getMax(),
+            trace.getAvg(),
+            percentile(0.5f),
+            percentile(0.9f),
+            percentile(0.99f),
+            percentile(0.999f));
+    };
+
+    printTrace(loop);
+    loop.reset();
+    for (auto trace : scheduler.getInstrumentation()) {
+        printTrace(*trace);
+        trace->reset();
+    }
+    print(fmt::format(
+        "Frame overruns: {}, skipped frames: {}\n", scheduler.getOverruns(), scheduler.getSkippedFrames()));
+
+    for (auto& c : callbacks) {
+        auto traces = c();
+        for (auto trace : traces) {
+            printTrace(*trace);
+            trace->reset();
         }
+    }
 
-        printTrace(printout);
+    printTrace(printout);
 
 // print memory usage stats
 #ifndef PIXELCLOCK_DESKTOP
 
-        printCentred("Memory Usage", headingWidth);
-
-        // print header row
-        print(fmt::format("{1:<{0}}", nameWidth, "Memory"));
-        print(fmt::format("{1:<{0}}", fieldWidth, "free (kB)"));
-        print(fmt::format("{1:<{0}}", fieldWidth, "total (kB)"));
-        print(fmt::format("{1:<{0}}", fieldWidth, "used (%)"));
-        print(fmt::format("{1:<{0}}", fieldWidth, "minfree (kB)"));
-        print(fmt::format("{1:<{0}}", fieldWidth, "maxalloc (kB)"));
-        print("\n");
-
-        // print heap stats
-        print(fmt::format("{1:<{0}}", nameWidth, "Heap"));
-        float usedHeapPercentage = 100 * (float(ESP.getHeapSize() - ESP.getFreeHeap()) / ESP.getHeapSize());
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getFreeHeap() / 1024));
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getHeapSize() / 1024));
-        print(fmt::format("{1:<{0}.2f}", fieldWidth, usedHeapPercentage));
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMinFreeHeap() / 1024));
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMaxAllocHeap() / 1024));
-        print("\n");
-
-        // print psram stats
-        float usedPsramPercentage = 100 * (float(ESP.getPsramSize() - ESP.getFreePsram()) / ESP.getPsramSize());
-        print(fmt::format("{1:<{0}}", nameWidth, "PSRAM"));
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getFreePsram() / 1024));
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getPsramSize() / 1024));
-        print(fmt::format("{1:<{0}.2f}", fieldWidth, usedPsramPercentage));
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMinFreePsram() / 1024));
-        print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMaxAllocPsram() / 1024));
-        print("\n");
+    printCentred("Memory Usage", headingWidth);
+
+    // print header row
+    print(fmt::format("{1:<{0}}", nameWidth, "Memory"));
+    print(fmt::format("{1:<{0}}", fieldWidth, "free (kB)"));
+    print(fmt::format("{1:<{0}}", fieldWidth, "total (kB)"));
+    print(fmt::format("{1:<{0}}", fieldWidth, "used (%)"));
+    print(fmt::format("{1:<{0}}", fieldWidth, "minfree (kB)"));
+    print(fmt::format("{1:<{0}}", fieldWidth, "maxalloc (kB)"));
+    print("\n");
+
+    // print heap stats
+    print(fmt::format("{1:<{0}}", nameWidth, "Heap"));
+    float usedHeapPercentage = 100 * (float(ESP.getHeapSize() - ESP.getFreeHeap()) / ESP.getHeapSize());
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getFreeHeap() / 1024));
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getHeapSize() / 1024));
+    print(fmt::format("{1:<{0}.2f}", fieldWidth, usedHeapPercentage));
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMinFreeHeap() / 1024));
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMaxAllocHeap() / 1024));
+    print("\n");
+
+    // print psram stats
+    float usedPsramPercentage = 100 * (float(ESP.getPsramSize() - ESP.getFreePsram()) / ESP.getPsramSize());
+    print(fmt::format("{1:<{0}}", nameWidth, "PSRAM"));
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getFreePsram() / 1024));
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getPsramSize() / 1024));
+    print(fmt::format("{1:<{0}.2f}", fieldWidth, usedPsramPercentage));
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMinFreePsram() / 1024));
+    print(fmt::format("{1:<{0}}", fieldWidth, ESP.getMaxAllocPsram() / 1024));
+    print("\n");
+
+#endif
 
+    memory::printPlacementReport();
+    tasks::TaskMonitorSingleton::get().printReport();
+#ifndef PIXELCLOCK_NO_TRACING
+    tracing::printReport();
+#endif
+#ifdef PIXELCLOCK_DESKTOP
+    tracing::updateTimelineFile();
 #endif
 
-        printout.stop();
-        lastStatReportTime = millis();
+    printout.stop();
+    lastStatReportTime = millis();
+}
+
+void LoopTimeManager::publishTelemetry() {
+    printout.start();
+
+    std::vector<InstrumentationTrace*> traces{&loop};
+    for (auto trace : scheduler.getInstrumentation()) { traces.push_back(trace); }
+    for (auto& c : callbacks) {
+        for (auto trace : c()) { traces.push_back(trace); }
+    }
+    traces.push_back(&printout);
+    if (traces.size() > telemetry::Sample::maxTraces) {
+        // the rest keep accumulating rather than being reset unseen
+        traces.resize(telemetry::Sample::maxTraces);
     }
 
-    loop.stop();
-    // ensure we yield at least once
-    yield();
-    while (millis() - lastLoopTime < desiredLoopDuration) {
-        // idle in this loop until desiredLoopDuration has elapsed
-        yield();
+    auto& stream = telemetry::TelemetrySingleton::get();
+    telemetry::Sample sample{};
+    sample.sequence = telemetrySequence++;
+    sample.timeMs = millis();
+    sample.overruns = scheduler.getOverruns();
+    sample.skippedFrames = scheduler.getSkippedFrames();
+    sample.dropped = stream.getDropped();
+#ifndef PIXELCLOCK_DESKTOP
+    sample.freeHeap = ESP.getFreeHeap();
+    sample.minFreeHeap = ESP.getMinFreeHeap();
+    sample.freePsram = ESP.getFreePsram();
+#endif
+    sample.traceCount = static_cast<uint8_t>(traces.size());
+    for (std::size_t i = 0; i < traces.size(); i++) {
+        const InstrumentationTrace& trace = *traces[i];
+        sample.traces[i] = {
+            trace.getHits(),
+            trace.getMin(),
+            trace.getMax(),
+            trace.getAvg(),
+            trace.hasPercentiles() ? trace.getPercentile(0.99f) : 0};
     }
-    loop.start();
-    lastLoopTime = millis();
-}
\ No newline at end of file
+
+    // names and the slower-moving reports go out now and then, so a decoder started mid-stream soon has them
+    if (sample.sequence % telemetryDetailInterval == 0) {
+        std::vector<std::string> names;
+        for (auto trace : traces) { names.push_back(trace->getName()); }
+        stream.publish(names);
+
+        std::vector<telemetry::PlacementEntry> placement;
+        for (const auto& r : memory::getPlacementReport()) {
+            placement.push_back(
+                {r.name,
+                 static_cast<uint8_t>(r.placement),
+                 static_cast<uint8_t>(r.region),
+                 r.liveBytes,
+                 r.liveCount,
+                 r.fallbacks});
+        }
+        stream.publish(placement);
+
+        std::vector<telemetry::TaskEntry> taskEntries;
+        for (const auto& t : tasks::TaskMonitorSingleton::get().takeReport()) {
+            taskEntries.push_back(
+                {t.config.name,
+                 t.config.core,
+                 t.config.priority,
+                 t.config.stackBytes,
+                 t.stackFreeMin,
+                 t.busyUs,
+                 t.intervalUs,
+                 t.missed});
+        }
+        stream.publish(taskEntries);
+
+#ifndef PIXELCLOCK_NO_TRACING
+        std::vector<telemetry::ScopedTraceEntry> scopedTraces;
+        for (const auto& p : tracing::takeReport()) {
+            scopedTraces.push_back({p.name, p.hits, p.minUs, p.maxUs, p.avgUs});
+        }
+        stream.publish(scopedTraces);
+#endif
+    }
+
+    for (auto trace : traces) { trace->reset(); }
+    stream.publish(sample);
+    // so the cost of publishing this sample is reported in the next one
+    printout.stop();
+    lastTelemetryTime = millis();
+}
@@ -1,7 +1,10 @@
 /* Project Scope */
+#include "allocationTracking.h"
 #include "audio/audio.h"
 #include "brightnessSensor.h"
 #include "display/diagnostic.h"
+#include "frameArena.h"
+#include "frameContext.h"
 #include "loopTimeManager.h"
 #include "modes/modes.h"
 #include "pinout.h"
@@ -27,6 +30,7 @@
 /* C++ Standard Library */
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -81,9 +85,19 @@ void brightnessButton_callback(Button2& btn) {
 }
 
 // Main loop timing
-constexpr uint32_t loopTargetTime = 15;    // Constant loop update rate to target (milliseconds)
+constexpr uint32_t loopTargetTime = frameRate::fullRatePeriod; // Loop update rate to target while animating (ms)
 constexpr uint32_t reportInterval = 10000; // Statistics on loop timing will be reported this often (milliseconds)
 LoopTimeManager loopTimeManager(loopTargetTime, reportInterval);
+FrameClock frameClock;
+analysis::BeatSync beatSync;
+uint32_t audioPublishedSeen = 0; // Audio history entries published by the previous frame
+// Set by the loop for the audio task: beats only wake the loop when what is on screen follows them
+std::atomic<bool> wakeOnBeats{false};
+
+#ifndef PIXELCLOCK_DESKTOP
+// Buttons are polled, so a press has to wake the loop when it is sleeping through a static display
+void IRAM_ATTR wakeOnButton() { loopTimeManager.wakeOnInputFromISR(); }
+#endif
 
 void setup() {
     delay(100);
@@ -159,6 +173,9 @@ void setup() {
     modeManager =
         std::make_unique<ModeManager>(baseCanvas, ButtonReferences{buttons[0], buttons[1], buttons[2], buttons[3]});
     loopTimeManager.registerTraceCallback([]() { return modeManager->getInstrumentation(); });
+    loopTimeManager.registerTraceCallback([]() { return FrameArenaSingleton::get().getInstrumentation(); });
+    loopTimeManager.registerTraceCallback(
+        []() { return alloc::AllocationMonitorSingleton::get().getInstrumentation(); });
 
     printCentred("Initialising Display", headingWidth);
 #ifdef PIXELCLOCK_DESKTOP
@@ -183,12 +200,18 @@ void setup() {
     buttons[2].begin(pins::button3, INPUT_PULLUP);
     buttons[3].begin(pins::button4, INPUT_PULLUP);
     buttons[4].begin(pins::button5, INPUT_PULLUP);
+    for (auto pin : {pins::button1, pins::button2, pins::button3, pins::button4, pins::button5}) {
+        attachInterrupt(digitalPinToInterrupt(pin), wakeOnButton, CHANGE);
+    }
 #endif
     buttons[4].setTapHandler(brightnessButton_callback);
 
     printCentred("Initialising Audio", headingWidth);
     AudioSingleton::get().begin();
     loopTimeManager.registerTraceCallback([]() { return AudioSingleton::get().getInstrumentation(); });
+    AudioSingleton::get().setEventCallback([]() {
+        if (wakeOnBeats.load(std::memory_order_relaxed)) { loopTimeManager.wake(); }
+    });
 
 
 
@@ -202,20 +225,41 @@ void loop() {
     // update buttons
     for (auto& b : buttons) { b.loop(); }
 
-    auto c = modeManager->run();
-    auto out = canvas::blit(baseCanvas, c, 0, 0);
-
-    display->setBrightness(brightnessModes[brightnessModeIndex].function());
-    display->update(out);
+    FrameContext frame = frameClock.tick(millis());
+    beatSync.apply(AudioSingleton::get().getBeatEvents(), frame);
+    const AudioHistory& audioHistory = AudioSingleton::get().getAudioCharacteristicsHistory();
+    // only frames showing newly analysed audio carry its capture time, so an idle stream doesn't read as latency
+    const uint32_t audioPublished = audioHistory.getPublishedCount();
+    if (audioPublished != audioPublishedSeen && !audioHistory.empty()) {
+        frame.audioCaptureUs = audioHistory.latest().captureTimeUs;
+    }
+    audioPublishedSeen = audioPublished;
+    auto c = modeManager->run(frame);
+
+    {
+        alloc::ScopeTag tag(alloc::Subsystem::display);
+        auto out = canvas::blit(baseCanvas, c, 0, 0);
+        display->setBrightness(brightnessModes[brightnessModeIndex].function());
+        display->update(out, frame);
+    }
 
     brightnessSensor->update();
 
     // AudioSingleton::get().update();
 
-    // processSerialCommands();
+#ifndef PIXELCLOCK_DESKTOP
+    processSerialCommands();
+#endif
 
     TimeManagerSingleton::get().update();
-    loopTimeManager.idle();
+
+    // sleep through frames that would not change the display, but not while a button is being handled
+    uint32_t updateInterval = modeManager->getUpdateInterval(frame);
+    wakeOnBeats.store(modeManager->usesBeats(), std::memory_order_relaxed);
+    if (std::any_of(buttons.begin(), buttons.end(), [](const Button2& b) { return b.isPressed(); })) {
+        updateInterval = frameRate::continuous;
+    }
+    loopTimeManager.idle(updateInterval);
 }
 
 #if defined PIXELCLOCK_DESKTOP
@@ -0,0 +1,189 @@
+/* Project Scope */
+#include "memoryPlacement.h"
+#include "FMTWrapper.h"
+#include "utility.h"
+
+/* Libraries */
+#ifndef PIXELCLOCK_DESKTOP
+#include <esp_heap_caps.h>
+#endif
+
+/* C++ Standard Library */
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace memory {
+
+namespace {
+
+struct Record {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<Placement> placement{Placement::hot};
+    std::atomic<Region> region{Region::internal};
+    std::atomic<uint32_t> liveBytes{0};
+    std::atomic<uint32_t> liveCount{0};
+    std::atomic<uint32_t> fallbacks{0};
+};
+
+// The last record collects any names beyond the others
+constexpr std::size_t maxRecords = 32;
+Record records[maxRecords];
+std::atomic<std::size_t> recordCount{0};
+std::atomic_flag registering = ATOMIC_FLAG_INIT;
+
+// Stored in front of each allocation, so release() knows what to account it against
+struct alignas(16) Header {
+    uint32_t bytes;
+    uint16_t record;
+    Region region;
+};
+
+Record& findRecord(const char* name, Placement placement) {
+    auto find = [&]() -> Record* {
+        const std::size_t count = recordCount.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; i++) {
+            const char* recorded = records[i].name.load(std::memory_order_relaxed);
+            if (recorded == name || std::strcmp(recorded, name) == 0) { return &records[i]; }
+        }
+        return nullptr;
+    };
+
+    if (Record* r = find()) { return *r; }
+
+    while (registering.test_and_set(std::memory_order_acquire)) {}
+    Record* r = find();
+    if (!r) {
+        const std::size_t count = recordCount.load(std::memory_order_relaxed);
+        if (count < maxRecords) {
+            r = &records[count];
+            r->name.store(count + 1 < maxRecords ? name : "Other", std::memory_order_relaxed);
+            r->placement.store(placement, std::memory_order_relaxed);
+            recordCount.store(count + 1, std::memory_order_release);
+        } else {
+            r = &records[maxRecords - 1];
+        }
+    }
+    registering.clear(std::memory_order_release);
+    return *r;
+}
+
+void* rawAllocate(std::size_t bytes, Region region) {
+#ifdef PIXELCLOCK_DESKTOP
+    return region == Region::internal ? std::malloc(bytes) : nullptr;
+#else
+    const uint32_t caps = region == Region::psram ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL;
+    return heap_caps_malloc(bytes, caps | MALLOC_CAP_8BIT);
+#endif
+}
+
+void rawFree(void* ptr) {
+#ifdef PIXELCLOCK_DESKTOP
+    std::free(ptr);
+#else
+    heap_caps_free(ptr);
+#endif
+}
+
+} // namespace
+
+const char* placementName(Placement placement) { return placement == Placement::hot ? "Hot" : "Bulk"; }
+
+const char* regionName(Region region) { return region == Region::internal ? "Internal" : "PSRAM"; }
+
+void* allocate(std::size_t bytes, Placement placement, const char* name) {
+    const Region preferred = placement == Placement::hot ? Region::internal : Region::psram;
+    const Region other = placement == Placement::hot ? Region::psram : Region::internal;
+
+    Region region = preferred;
+    void* raw = rawAllocate(sizeof(Header) + bytes, preferred);
+    if (!raw) {
+        region = other;
+        raw = rawAllocate(sizeof(Header) + bytes, other);
+    }
+    if (!raw) { return nullptr; }
+
+    Record& r = findRecord(name, placement);
+    r.region.store(region, std::memory_order_relaxed);
+    r.liveBytes.fetch_add(static_cast<uint32_t>(bytes), std::memory_order_relaxed);
+    r.liveCount.fetch_add(1, std::memory_order_relaxed);
+    if (region != preferred) { r.fallbacks.fetch_add(1, std::memory_order_relaxed); }
+
+    Header* header = static_cast<Header*>(raw);
+    header->bytes = static_cast<uint32_t>(bytes);
+    header->record = static_cast<uint16_t>(&r - records);
+    header->region = region;
+    return header + 1;
+}
+
+void* allocateOrFail(std::size_t bytes, Placement placement, const char* name) {
+    void* p = allocate(bytes, placement, name);
+    if (!p) {
+#if defined(__cpp_exceptions)
+        throw std::bad_alloc();
+#else
+        std::abort();
+#endif
+    }
+    return p;
+}
+
+void release(void* ptr) {
+    if (!ptr) { return; }
+    Header* header = static_cast<Header*>(ptr) - 1;
+    Record& r = records[header->record];
+    r.liveBytes.fetch_sub(header->bytes, std::memory_order_relaxed);
+    r.liveCount.fetch_sub(1, std::memory_order_relaxed);
+    rawFree(header);
+}
+
+std::vector<PlacementRecord> getPlacementReport() {
+    std::vector<PlacementRecord> report;
+    const std::size_t count = recordCount.load(std::memory_order_acquire);
+    report.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const Record& r = records[i];
+        report.push_back(
+            {r.name.load(std::memory_order_relaxed),
+             r.placement.load(std::memory_order_relaxed),
+             r.region.load(std::memory_order_relaxed),
+             r.liveBytes.load(std::memory_order_relaxed),
+             r.liveCount.load(std::memory_order_relaxed),
+             r.fallbacks.load(std::memory_order_relaxed)});
+    }
+    return report;
+}
+
+void printPlacementReport() {
+    using namespace printing;
+
+    constexpr int nameWidth = 30;
+    constexpr int fieldWidth = 15;
+
+    printCentred("Memory Placement", headingWidth);
+    print(fmt::format(
+        "{2:<{0}}{3:<{1}}{4:<{1}}{5:<{1}}{6:<{1}}{7:<{1}}\n",
+        nameWidth,
+        fieldWidth,
+        "Buffer",
+        "Wanted",
+        "Landed",
+        "Live (B)",
+        "Live (count)",
+        "Fallbacks"));
+    for (const auto& r : getPlacementReport()) {
+        print(fmt::format(
+            "{2:<{0}}{3:<{1}}{4:<{1}}{5:<{1}}{6:<{1}}{7:<{1}}\n",
+            nameWidth,
+            fieldWidth,
+            r.name,
+            placementName(r.placement),
+            regionName(r.region),
+            r.liveBytes,
+            r.liveCount,
+            r.fallbacks));
+    }
+}
+
+} // namespace memory
@@ -1,14 +1,21 @@
 /* Project Scope */
 #include "modes/clockface.h"
 #include "FMTWrapper.h"
+#include "allocationTracking.h"
 #include "display/canvas.h"
 #include "display/effects/clockfaces.h"
 #include "utility.h"
 
+/* C++ Standard Library */
+#include <algorithm>
+
 using namespace printing;
 
-Mode_ClockFace::Mode_ClockFace(ButtonReferences buttons) : MainModeFunction("Clockface", buttons) {
+namespace {
+
+std::vector<std::unique_ptr<DisplayEffect>> defaultFaces() {
     auto timeCallback = []() { return timeCallbackFunction(TimeManagerSingleton::get().now()); };
+    std::vector<std::unique_ptr<DisplayEffect>> faces;
     faces.push_back(std::make_unique<ClockFace_GravityFill>(
         timeCallback, std::make_unique<GravityFillTemplate>(GravityFillTemplate::FillMode::leftRightPerRow)));
     faces.push_back(std::make_unique<ClockFace_GravityFill>(
@@ -17,8 +24,30 @@ Mode_ClockFace::Mode_ClockFace(ButtonReferences buttons) : MainModeFunction("Clo
         timeCallback, std::make_unique<GravityFillTemplate>(GravityFillTemplate::FillMode::random)));
     faces.push_back(std::make_unique<ClockFace_Gravity>(timeCallback));
     faces.push_back(std::make_unique<ClockFace_Simple>(timeCallback));
+    return faces;
+}
+
+std::vector<std::unique_ptr<FilterMethod>> defaultFilters() {
+    std::vector<std::unique_ptr<FilterMethod>> filters;
     filters.push_back(std::make_unique<RainbowWave>(50.0f, 30, RainbowWave::Direction::horizontal, false));
     filters.push_back(std::make_unique<RainbowWave>(50.0f, 30, RainbowWave::Direction::vertical, false));
+    return filters;
+}
+
+} // namespace
+
+Mode_ClockFace::Mode_ClockFace(const canvas::Canvas& size, ButtonReferences buttons)
+    : Mode_ClockFace(size, buttons, defaultFaces(), defaultFilters()) {}
+
+Mode_ClockFace::Mode_ClockFace(
+    const canvas::Canvas& size,
+    ButtonReferences buttons,
+    std::vector<std::unique_ptr<DisplayEffect>> faces,
+    std::vector<std::unique_ptr<FilterMethod>> filters)
+    : MainModeFunction("Clockface", buttons),
+      faces(std::move(faces)),
+      filters(std::move(filters)),
+      faceTransition(size) {
     timePrev = timeCallbackFunction();
 }
 
@@ -34,9 +63,13 @@ void Mode_ClockFace::moveIntoCore() {
     buttons.mode.setTapHandler([this]([[maybe_unused]] Button2& btn) { this->_finished = true; });
 }
 
-canvas::Canvas Mode_ClockFace::runCore() {
-    auto c = faces[clockfaceIndex]->run();
-    if (faces[clockfaceIndex]->finished()) { faces[clockfaceIndex]->reset(); }
+canvas::Canvas Mode_ClockFace::runCore(const FrameContext& frame) {
+    canvas::Canvas c;
+    {
+        alloc::ScopeTag tag(alloc::Subsystem::effect);
+        c = faces[clockfaceIndex]->run(frame);
+        if (faces[clockfaceIndex]->finished()) { faces[clockfaceIndex]->reset(); }
+    }
 
     auto timeNow = timeCallbackFunction();
 
@@ -44,7 +77,7 @@ canvas::Canvas Mode_ClockFace::runCore() {
     if (timeNow.minute != timePrev.minute) {
         filterIndex++;
         if (filterIndex == filters.size()) { filterIndex = 0; }
-        lastFilterChangeTime = millis();
+        lastFilterChangeTime = frame.timeMs;
     }
 
     // Every hour, switch to random clockface
@@ -54,11 +87,32 @@ canvas::Canvas Mode_ClockFace::runCore() {
         clockfaceIndex = dist(rand);
         printing::print(fmt::format("Mode_ClockFace switching to new face randomly. New index: {}\n", clockfaceIndex));
         faces[clockfaceIndex]->reset();
+        const uint32_t transitionDuration = 1000; // milliseconds
+        faceTransition.start(c, transitions::Type::dissolve, transitionDuration);
+
+        // the transition blends towards the new face from this frame on, so draw it now
+        alloc::ScopeTag tag(alloc::Subsystem::effect);
+        c = faces[clockfaceIndex]->run(frame);
+        if (faces[clockfaceIndex]->finished()) { faces[clockfaceIndex]->reset(); }
     }
 
     timePrev = timeNow;
 
-    if (filterIndex < filters.size() && filters[filterIndex]) { filters[filterIndex]->apply(c); }
+    if (faceTransition.active()) { c = faceTransition.apply(c, frame); }
+
+    if (filterIndex < filters.size() && filters[filterIndex]) {
+        alloc::ScopeTag tag(alloc::Subsystem::effect);
+        filters[filterIndex]->apply(c, frame);
+    }
 
     return c;
 }
+
+uint32_t Mode_ClockFace::getUpdateInterval(const FrameContext& frame) const {
+    if (faceTransition.active()) { return frameRate::continuous; }
+    uint32_t interval = faces[clockfaceIndex]->getUpdateInterval(frame);
+    if (filterIndex < filters.size() && filters[filterIndex]) {
+        interval = std::min(interval, filters[filterIndex]->getUpdateInterval());
+    }
+    return interval;
+}
@@ -1,6 +1,7 @@
 /* Project Scope */
 #include "modes/effects.h"
 #include "FMTWrapper.h"
+#include "allocationTracking.h"
 #include "display/canvas.h"
 #include "display/effects/audiowaterfall.h"
 #include "display/effects/bouncingball.h"
@@ -16,7 +17,8 @@
 using namespace printing;
 
 Mode_Effects::Mode_Effects(const canvas::Canvas& size, ButtonReferences buttons)
-    : MainModeFunction("Effects", buttons) {
+    : MainModeFunction("Effects", buttons),
+      transition(size) {
     effects.push_back({"Audio Waterfall", std::make_unique<AudioWaterfall>(size)});
     effects.push_back({"Volume Graph", std::make_unique<VolumeGraph>(size)});
     effects.push_back({"Volume Display", std::make_unique<VolumeDisplay>(size)});
@@ -34,78 +36,46 @@ void Mode_Effects::moveIntoCore() {
     effects[effectIndex].ptr->reset();
 
     auto cycleHandler = [&](Button2& btn) {
-        if (currentState != State::Transition) {
+        if (!transition.active() && transitionDir == 0) {
             if (btn == buttons.left) {
                 transitionDir = -1;
             } else {
                 transitionDir = 1;
             }
             print(fmt::format("Switching to next effect. Direction: {:+d}\n", transitionDir));
-            currentState = State::Transition;
         }
     };
 
     buttons.left.setTapHandler(cycleHandler);
     buttons.right.setTapHandler(cycleHandler);
+
+    buttons.select.setTapHandler([this]([[maybe_unused]] Button2& btn) {
+        transitionType = static_cast<transitions::Type>((static_cast<int>(transitionType) + 1) % 4);
+        print(fmt::format("Effect transition type: {}\n", transitions::typeName(transitionType)));
+    });
     buttons.mode.setTapHandler([this]([[maybe_unused]] Button2& btn) { this->_finished = true; });
 }
 
-canvas::Canvas Mode_Effects::runCore() {
+canvas::Canvas Mode_Effects::runCore(const FrameContext& frame) {
 
-    uint32_t millisSinceLastRun = millis() - lastLoopTime;
-    float tdelta = static_cast<float>(millisSinceLastRun) / 1000;
-    lastLoopTime = millis();
+    if (transitionDir != 0) {
+        // hold the last frame of the current effect and blend away from it while the next effect runs
+        const uint32_t transitionDuration = 200; // milliseconds
+        alloc::ScopeTag tag(alloc::Subsystem::effect);
+        transition.start(effects[effectIndex].ptr->run(frame), transitionType, transitionDuration, transitionDir);
+        effectIndex = (effects.size() + transitionDir + effectIndex) % effects.size();
+        transitionDir = 0;
+        print(fmt::format("Effect Transition Started, New Effect = {} - {}\n", effectIndex, effects[effectIndex].name));
+    }
 
     canvas::Canvas c;
-    switch (currentState) {
-    case State::Stable: {
-        c = effects[effectIndex].ptr->run();
+    {
+        alloc::ScopeTag tag(alloc::Subsystem::effect);
+        c = effects[effectIndex].ptr->run(frame);
         if (effects[effectIndex].ptr->finished()) { effects[effectIndex].ptr->reset(); }
-        break;
     }
-    case State::Transition: {
-        print(fmt::format("State::Transition - {} - {}\n", transitionPercentage, transitionDir));
-        std::size_t effectIdxLeft = (effects.size() - 1 + effectIndex) % effects.size();
-        std::size_t effectIdxRight = (effects.size() + 1 + effectIndex) % effects.size();
-        print(fmt::format("Left Current Right - {} {} {}\n", effectIdxLeft, effectIndex, effectIdxRight));
-        canvas::Canvas cl = effects[effectIdxLeft].ptr->run();
-        canvas::Canvas cm = effects[effectIndex].ptr->run();
-        canvas::Canvas cr = effects[effectIdxRight].ptr->run();
-        canvas::Canvas cb(cm);
-        cb.fill(0);
-
-        const float transitionDuration = 0.2f; // seconds
-        transitionPercentage += (1.0f / transitionDuration) * tdelta;
-
-        auto easeInOutCubic = [](float t) -> float {
-            if (t < 0.5) {
-                return 4 * t * t * t;
-            } else {
-                float f = ((2 * t) - 2);
-                return 0.5f * f * f * f + 1;
-            }
-        };
-
-        float transitionPositionEased = easeInOutCubic(transitionPercentage);
 
-        int xOffset = static_cast<int>(std::round((transitionPositionEased * -transitionDir) * cb.getWidth()));
-
-        cb = canvas::blit(cb, cl, xOffset - cb.getWidth(), 0);
-        cb = canvas::blit(cb, cm, xOffset, 0);
-        cb = canvas::blit(cb, cr, xOffset + cb.getWidth(), 0);
-
-        if (transitionPercentage >= 1.0) {
-            effectIndex = (effects.size() + transitionDir + effectIndex) % effects.size();
-            print(fmt::format(
-                "Effect Transition Finished, New Effect = {} - {}\n", effectIndex, effects[effectIndex].name));
-            currentState = State::Stable;
-            transitionPercentage = 0;
-        }
-
-        c = cb;
-        break;
-    }
-    }
+    if (transition.active()) { c = transition.apply(c, frame); }
 
     return c;
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 /* Project Scope */
 #include "modes/modes.h"
 #include "FMTWrapper.h"
+#include "allocationTracking.h"
 #include "display/canvas.h"
 #include "modes/clockface.h"
 #include "modes/effects.h"
 #include "modes/settings.h"
+#include "tracing.h"
 #include "utility.h"
 
 using namespace printing;
@@ -34,7 +36,7 @@ void MainModeFunction::moveIntoCore() {
     buttons.mode.setTapHandler([this]([[maybe_unused]] Button2& btn) { _finished = true; });
 }
 
-canvas::Canvas MainModeFunction::run() { return this->runCore(); }
+canvas::Canvas MainModeFunction::run(const FrameContext& frame) { return this->runCore(frame); }
 
 void MainModeFunction::moveOut() {
     clearAllButtonCallbacks(buttons.mode);
@@ -44,22 +46,37 @@ void MainModeFunction::moveOut() {
     this->moveOutCore();
 }
 
-ModeManager::ModeManager(const canvas::Canvas& size, ButtonReferences buttons) {
-    modes.push_back(std::make_unique<Mode_ClockFace>(buttons));
+ModeManager::ModeManager(const canvas::Canvas& size, ButtonReferences buttons) : transition(size) {
+    modes.push_back(std::make_unique<Mode_ClockFace>(size, buttons));
     modes.push_back(std::make_unique<Mode_Effects>(size, buttons));
     modes.push_back(std::make_unique<Mode_SettingsMenu>(size, buttons));
     modes[modeIndex]->moveInto();
 }
 
-canvas::Canvas ModeManager::run() {
+canvas::Canvas ModeManager::run(const FrameContext& frame) {
     traceRunTotal.start();
-    const auto c = modes[modeIndex]->run();
-    if (modes[modeIndex]->finished()) { cycleMode(); }
+    alloc::ScopeTag tag(alloc::Subsystem::mode);
+    auto c = modes[modeIndex]->run(frame);
+    if (transition.active()) { c = transition.apply(c, frame); }
+    if (modes[modeIndex]->finished()) {
+        // hold the last frame of the outgoing mode and fade from it into the next mode
+        const uint32_t transitionDuration = 300; // milliseconds
+        transition.start(c, transitions::Type::crossfade, transitionDuration);
+        cycleMode();
+    }
     traceRunTotal.stop();
     return c;
 }
 
+uint32_t ModeManager::getUpdateInterval(const FrameContext& frame) const {
+    if (transition.active()) { return frameRate::continuous; }
+    return modes[modeIndex]->getUpdateInterval(frame);
+}
+
+bool ModeManager::usesBeats() const { return modes[modeIndex]->usesBeats(); }
+
 void ModeManager::cycleMode() {
+    PIXELCLOCK_TRACE_SCOPE("Mode Switch");
     using namespace printing;
 
     print("Switching to next mode...\n");
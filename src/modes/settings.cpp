@@ -65,10 +65,10 @@ void Mode_SettingsMenu::registerButtonCallbacks() {
     print("Registered settings button callbacks\n");
 }
 
-canvas::Canvas Mode_SettingsMenu::runCore() {
+canvas::Canvas Mode_SettingsMenu::runCore(const FrameContext& frame) {
     canvas::Canvas c;
     if (activeMenuPage) {
-        c = activeMenuPage->run();
+        c = activeMenuPage->run(frame);
         if (activeMenuPage->finished()) {
             activeMenuPage->moveOut();
             activeMenuPage.reset();
@@ -76,7 +76,7 @@ canvas::Canvas Mode_SettingsMenu::runCore() {
             menuTextScroller->reset();
         }
     } else {
-        c = menuTextScroller->run();
+        c = menuTextScroller->run(frame);
     }
     return c;
 }
@@ -187,7 +187,7 @@ void Mode_SettingsMenu_SetTime::moveIntoCore() {
     textscroller->setTargetOffset(5);
 }
 
-canvas::Canvas Mode_SettingsMenu_SetTime::runCore() {
+canvas::Canvas Mode_SettingsMenu_SetTime::runCore(const FrameContext& frame) {
     // update the scroller text
     auto times = timeCallbackFunction(TimeManagerSingleton::get().now() + this->secondsOffset);
     std::string timestr = fmt::format("back {:2d}:{:2d}:{:2d} ok", times.hour24, times.minute, times.second);
@@ -313,5 +313,5 @@ canvas::Canvas Mode_SettingsMenu_SetTime::runCore() {
         break;
     }
     }
-    return textscroller->run();
+    return textscroller->run(frame);
 }
\ No newline at end of file
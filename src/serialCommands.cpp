@@ -1,6 +1,8 @@
 /* Project Scope */
 #include "FMTWrapper.h"
+#include "telemetry.h"
 #include "timekeeping.h"
+#include "timeline.h"
 #include "utility.h"
 
 /* Arduino Core */
@@ -11,48 +13,78 @@
 #include <vector>
 
 void processSerialCommands() {
-    if (Serial.available()) {
-        std::string receivedCommand(Serial.readString().c_str());
-        std::vector<std::string> substrings;
-
-        // Split the string into substrings
-        while (receivedCommand.length() > 0) {
-            std::size_t index = receivedCommand.find(' ');
-            if (index == receivedCommand.npos) {
-                // No space found
-                substrings.push_back(receivedCommand);
-                break;
-            } else {
-                substrings.push_back(receivedCommand.substr(0, index));
-                receivedCommand = receivedCommand.substr(index + 1);
-            }
+    // Serial.readString() blocks until its timeout, so collect characters as they arrive and handle whole lines
+    static std::string line;
+    bool complete = false;
+    while (Serial.available() && !complete) {
+        const char ch = static_cast<char>(Serial.read());
+        if (ch == '\n' || ch == '\r') {
+            complete = !line.empty();
+        } else if (line.size() < 64) {
+            line += ch;
         }
+    }
+    if (!complete) { return; }
+
+    std::string receivedCommand = line;
+    line.clear();
+    std::vector<std::string> substrings;
 
-        if (!substrings.empty()) {
-            Serial.print("Received command: ");
-            for (const auto& str : substrings) { printing::print(fmt::to_string(str)); }
-            Serial.print("\n");
-
-            if (substrings[0] == "T") {
-                // YYYY MM DD HH MM SS
-                if (substrings.size() == 7) {
-                    int year = std::stoi(substrings[1]);
-                    int month = std::stoi(substrings[2]);
-                    int day = std::stoi(substrings[3]);
-                    int hour = std::stoi(substrings[4]);
-                    int min = std::stoi(substrings[5]);
-                    int sec = std::stoi(substrings[6]);
-
-                    TimeElements time;
-                    time.Year = uint8_t(CalendarYrToTm(year));
-                    time.Month = uint8_t(month);
-                    time.Day = uint8_t(day);
-                    time.Hour = uint8_t(hour);
-                    time.Minute = uint8_t(min);
-                    time.Second = uint8_t(sec);
-                    TimeManagerSingleton::get().setTime(makeTime(time));
+    // Split the string into substrings
+    while (receivedCommand.length() > 0) {
+        std::size_t index = receivedCommand.find(' ');
+        if (index == receivedCommand.npos) {
+            // No space found
+            substrings.push_back(receivedCommand);
+            break;
+        } else {
+            substrings.push_back(receivedCommand.substr(0, index));
+            receivedCommand = receivedCommand.substr(index + 1);
+        }
+    }
+
+    if (!substrings.empty()) {
+        Serial.print("Received command: ");
+        for (const auto& str : substrings) { printing::print(fmt::to_string(str)); }
+        Serial.print("\n");
+
+        if (substrings[0] == "T") {
+            // YYYY MM DD HH MM SS
+            if (substrings.size() == 7) {
+                int year = std::stoi(substrings[1]);
+                int month = std::stoi(substrings[2]);
+                int day = std::stoi(substrings[3]);
+                int hour = std::stoi(substrings[4]);
+                int min = std::stoi(substrings[5]);
+                int sec = std::stoi(substrings[6]);
+
+                TimeElements time;
+                time.Year = uint8_t(CalendarYrToTm(year));
+                time.Month = uint8_t(month);
+                time.Day = uint8_t(day);
+                time.Hour = uint8_t(hour);
+                time.Minute = uint8_t(min);
+                time.Second = uint8_t(sec);
+                TimeManagerSingleton::get().setTime(makeTime(time));
+            }
+        } else if (substrings[0] == "TRACE") {
+            // START | STOP | DUMP
+            if (substrings.size() == 2) {
+                const std::string& action = substrings[1];
+                if (action == "START") {
+                    tracing::startTimeline();
+                } else if (action == "STOP") {
+                    tracing::stopTimeline();
+                } else if (action == "DUMP") {
+#ifdef PIXELCLOCK_BINARY_TELEMETRY
+                    // printed JSON would interleave with the telemetry task's frames, so it goes through the stream
+                    telemetry::TelemetrySingleton::get().publishTimeline(tracing::TimelineSingleton::get());
+#else
+                    tracing::TimelineSingleton::get().writeChromeTrace(
+                        [](const std::string& piece) { printing::print(piece); });
+#endif
                 }
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+/* Project Scope */
+#include "tasks.h"
+#include "FMTWrapper.h"
+#include "utility.h"
+
+/* Arduino Core */
+#include <Arduino.h>
+
+/* C++ Standard Library */
+#include <cstring>
+#include <string>
+
+namespace tasks {
+
+void TaskStats::attachCurrentTask() {
+#ifndef PIXELCLOCK_DESKTOP
+    attach(xTaskGetCurrentTaskHandle());
+#endif
+}
+
+void TaskStats::workStart() {
+    workStartUs = micros();
+    working = true;
+}
+
+void TaskStats::workStop() {
+    if (!working) { return; }
+    busyUs.fetch_add(static_cast<uint32_t>(micros()) - workStartUs, std::memory_order_relaxed);
+    working = false;
+}
+
+void TaskStats::woke(uint32_t notifications) {
+    if (notifications > 1) { missed.fetch_add(notifications - 1, std::memory_order_relaxed); }
+}
+
+int32_t TaskStats::getStackFreeMin() const {
+#ifdef PIXELCLOCK_DESKTOP
+    return -1;
+#else
+    void* h = handle.load(std::memory_order_relaxed);
+    if (!h) { return -1; }
+    // ESP-IDF reports the high-water mark in bytes
+    return static_cast<int32_t>(uxTaskGetStackHighWaterMark(static_cast<TaskHandle_t>(h)));
+#endif
+}
+
+TaskStats& TaskMonitor::add(const TaskConfig& config) {
+    for (std::size_t i = 0; i < taskCount; i++) {
+        if (std::strcmp(tasks[i]->config.name, config.name) == 0) { return *tasks[i]; }
+    }
+    if (taskCount == maxTasks) {
+        printing::print(fmt::format("TaskMonitor: no room for task {}, sharing the last entry\n", config.name));
+        return *tasks[maxTasks - 1];
+    }
+    tasks[taskCount] = std::unique_ptr<TaskStats>(new TaskStats(config));
+    return *tasks[taskCount++];
+}
+
+std::vector<TaskReport> TaskMonitor::takeReport() {
+    const uint32_t nowUs = micros();
+    const uint32_t intervalUs = nowUs - lastReportUs;
+    lastReportUs = nowUs;
+
+    std::vector<TaskReport> report;
+    for (std::size_t i = 0; i < taskCount; i++) {
+        TaskStats& t = *tasks[i];
+        report.push_back({t.config, t.getStackFreeMin(), t.takeBusyUs(), intervalUs, t.takeMissed()});
+    }
+    return report;
+}
+
+void TaskMonitor::printReport() {
+    using namespace printing;
+
+    constexpr int nameWidth = 30;
+    constexpr int fieldWidth = 15;
+
+    auto printRow = [&](auto... fields) {
+        print(fmt::format(
+            "{2:<{0}}{3:<{1}}{4:<{1}}{5:<{1}}{6:<{1}}{7:<{1}}{8:<{1}}\n", nameWidth, fieldWidth, fields...));
+    };
+
+    printCentred("Tasks", headingWidth);
+    printRow("Task", "Core", "Priority", "Stack (B)", "Stack min free", "CPU (%)", "Missed");
+    for (const TaskReport& t : takeReport()) {
+        const TaskConfig& c = t.config;
+        const float cpu = t.intervalUs ? 100.0f * t.busyUs / t.intervalUs : 0.0f;
+        printRow(
+            c.name,
+            c.core == anyCore ? std::string("Any") : std::to_string(c.core),
+            c.priority,
+            c.stackBytes,
+            t.stackFreeMin < 0 ? std::string("-") : std::to_string(t.stackFreeMin),
+            fmt::format("{:.1f}", cpu),
+            t.missed);
+    }
+}
+
+TaskMonitor& TaskMonitorSingleton::get() {
+    static TaskMonitor instance;
+    return instance;
+}
+
+void* spawn(const TaskConfig& config, void (*function)(void*), void* parameter) {
+    TaskStats& stats = TaskMonitorSingleton::get().add(config);
+#ifdef PIXELCLOCK_DESKTOP
+    (void)stats;
+    (void)function;
+    (void)parameter;
+    return nullptr;
+#else
+    TaskHandle_t created = nullptr;
+    const BaseType_t core = config.core == anyCore ? tskNO_AFFINITY : config.core;
+    const auto result =
+        xTaskCreatePinnedToCore(function, config.name, config.stackBytes, parameter, config.priority, &created, core);
+    if (result != pdPASS) { return nullptr; }
+    stats.attach(created);
+    return created;
+#endif
+}
+
+} // namespace tasks
@@ -0,0 +1,452 @@
+/* Project Scope */
+#include "telemetry.h"
+#include "tasks.h"
+#include "timeline.h"
+
+/* Arduino Core */
+#include <Arduino.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+
+namespace telemetry {
+
+static_assert(samplePayloadSize <= maxPayloadSize, "Samples must fit in a frame");
+
+namespace {
+
+class Writer {
+public:
+    explicit Writer(etl::span<uint8_t> out) : out(out) {}
+
+    void u8(uint8_t value) {
+        if (position < out.size()) { out[position] = value; }
+        position++;
+    }
+    void u16(uint16_t value) {
+        u8(static_cast<uint8_t>(value));
+        u8(static_cast<uint8_t>(value >> 8));
+    }
+    void u32(uint32_t value) {
+        u16(static_cast<uint16_t>(value));
+        u16(static_cast<uint16_t>(value >> 16));
+    }
+    // Raw bytes to the end of the payload, for text too long for str()
+    void text(const std::string& s) {
+        for (char c : s) { u8(static_cast<uint8_t>(c)); }
+    }
+    void str(const std::string& s) {
+        const std::size_t length = std::min<std::size_t>(s.size(), 255);
+        u8(static_cast<uint8_t>(length));
+        for (std::size_t c = 0; c < length; c++) { u8(static_cast<uint8_t>(s[c])); }
+    }
+    // A count, then 'write' for each of up to 255 entries
+    template <typename T, typename Function> void list(const std::vector<T>& entries, Function write) {
+        const std::size_t count = std::min<std::size_t>(entries.size(), 255);
+        u8(static_cast<uint8_t>(count));
+        for (std::size_t i = 0; i < count; i++) { write(entries[i]); }
+    }
+
+    std::size_t size() const { return position; }
+    bool overflowed() const { return position > out.size(); }
+
+private:
+    etl::span<uint8_t> out;
+    std::size_t position = 0;
+};
+
+class Reader {
+public:
+    explicit Reader(etl::span<const uint8_t> in) : in(in) {}
+
+    uint8_t u8() { return position < in.size() ? in[position++] : (overrun = true, 0); }
+    uint16_t u16() {
+        const uint16_t low = u8();
+        return static_cast<uint16_t>(low | (u8() << 8));
+    }
+    uint32_t u32() {
+        const uint32_t low = u16();
+        return low | (uint32_t(u16()) << 16);
+    }
+    std::string str() {
+        const std::size_t length = u8();
+        if (position + length > in.size()) {
+            overrun = true;
+            return {};
+        }
+        std::string s(reinterpret_cast<const char*>(in.data() + position), length);
+        position += length;
+        return s;
+    }
+
+    // Everything left in the payload
+    std::string text() {
+        std::string s(reinterpret_cast<const char*>(in.data() + position), in.size() - position);
+        position = in.size();
+        return s;
+    }
+
+    template <typename T, typename Function> std::vector<T> list(Function read) {
+        std::vector<T> entries(u8());
+        for (auto& entry : entries) { read(entry); }
+        return entries;
+    }
+
+    bool ok() const { return !overrun; }
+
+private:
+    etl::span<const uint8_t> in;
+    std::size_t position = 0;
+    bool overrun = false;
+};
+
+// Writes the header, calls 'payload' to write the payload, then fills in its length and appends the CRC
+template <typename Function> std::size_t encodeFrame(FrameType type, etl::span<uint8_t> out, Function payload) {
+    Writer w(out);
+    w.u8(syncBytes[0]);
+    w.u8(syncBytes[1]);
+    w.u8(protocolVersion);
+    w.u8(static_cast<uint8_t>(type));
+    w.u16(0);
+    payload(w);
+    const std::size_t payloadSize = w.size() - headerSize;
+    if (w.overflowed() || out.size() - w.size() < crcSize || payloadSize > maxPayloadSize) { return 0; }
+
+    out[4] = static_cast<uint8_t>(payloadSize);
+    out[5] = static_cast<uint8_t>(payloadSize >> 8);
+    w.u16(crc16(out.subspan(2, w.size() - 2)));
+    return w.size();
+}
+
+} // namespace
+
+uint16_t crc16(etl::span<const uint8_t> data, uint16_t crc) {
+    for (uint8_t byte : data) {
+        crc ^= static_cast<uint16_t>(byte << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = static_cast<uint16_t>(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+        }
+    }
+    return crc;
+}
+
+std::size_t encode(const Sample& sample, etl::span<uint8_t> out) {
+    return encodeFrame(FrameType::sample, out, [&](Writer& w) {
+        w.u32(sample.sequence);
+        w.u32(sample.timeMs);
+        w.u32(sample.overruns);
+        w.u32(sample.skippedFrames);
+        w.u32(sample.dropped);
+        w.u32(sample.freeHeap);
+        w.u32(sample.minFreeHeap);
+        w.u32(sample.freePsram);
+        const uint8_t count = static_cast<uint8_t>(std::min<std::size_t>(sample.traceCount, Sample::maxTraces));
+        w.u8(count);
+        for (std::size_t i = 0; i < count; i++) {
+            const TraceSummary& t = sample.traces[i];
+            w.u32(t.hits);
+            w.u32(t.minUs);
+            w.u32(t.maxUs);
+            w.u32(t.avgUs);
+            w.u32(t.p99Us);
+        }
+    });
+}
+
+std::size_t encode(const std::vector<std::string>& traceNames, etl::span<uint8_t> out) {
+    return encodeFrame(FrameType::traceNames, out, [&](Writer& w) {
+        w.list(traceNames, [&](const std::string& name) { w.str(name); });
+    });
+}
+
+std::size_t encode(const std::vector<PlacementEntry>& placement, etl::span<uint8_t> out) {
+    return encodeFrame(FrameType::placement, out, [&](Writer& w) {
+        w.list(placement, [&](const PlacementEntry& e) {
+            w.str(e.name);
+            w.u8(e.placement);
+            w.u8(e.region);
+            w.u32(e.liveBytes);
+            w.u32(e.liveCount);
+            w.u32(e.fallbacks);
+        });
+    });
+}
+
+std::size_t encode(const std::vector<TaskEntry>& tasks, etl::span<uint8_t> out) {
+    return encodeFrame(FrameType::tasks, out, [&](Writer& w) {
+        w.list(tasks, [&](const TaskEntry& e) {
+            w.str(e.name);
+            w.u8(static_cast<uint8_t>(e.core));
+            w.u8(e.priority);
+            w.u32(e.stackBytes);
+            w.u32(static_cast<uint32_t>(e.stackFreeMin));
+            w.u32(e.busyUs);
+            w.u32(e.intervalUs);
+            w.u32(e.missed);
+        });
+    });
+}
+
+std::size_t encode(const std::vector<ScopedTraceEntry>& scopedTraces, etl::span<uint8_t> out) {
+    return encodeFrame(FrameType::scopedTraces, out, [&](Writer& w) {
+        w.list(scopedTraces, [&](const ScopedTraceEntry& e) {
+            w.str(e.name);
+            w.u32(e.hits);
+            w.u32(e.minUs);
+            w.u32(e.maxUs);
+            w.u32(e.avgUs);
+        });
+    });
+}
+
+std::size_t encode(const TimelineChunk& chunk, etl::span<uint8_t> out) {
+    return encodeFrame(FrameType::timeline, out, [&](Writer& w) {
+        w.u8(static_cast<uint8_t>((chunk.first ? 1 : 0) | (chunk.last ? 2 : 0)));
+        w.text(chunk.json);
+    });
+}
+
+void Decoder::feed(etl::span<const uint8_t> data) {
+    buffer.insert(buffer.end(), data.begin(), data.end());
+    const std::size_t consumed = decodeBuffered();
+    buffer.erase(buffer.begin(), buffer.begin() + consumed);
+}
+
+std::size_t Decoder::decodeBuffered() {
+    std::size_t start = 0;
+    while (true) {
+        // find the next sync
+        std::size_t next = start;
+        while (next + 1 < buffer.size() && !(buffer[next] == syncBytes[0] && buffer[next + 1] == syncBytes[1])) {
+            next++;
+        }
+        skippedBytes += static_cast<uint32_t>(next - start);
+        start = next;
+
+        if (buffer.size() - start < headerSize) { return start; }
+        const uint8_t version = buffer[start + 2];
+        const auto type = static_cast<FrameType>(buffer[start + 3]);
+        const std::size_t payloadSize = buffer[start + 4] | (std::size_t(buffer[start + 5]) << 8);
+        if (payloadSize > maxPayloadSize) {
+            // not a real frame start
+            start++;
+            skippedBytes++;
+            continue;
+        }
+        const std::size_t frameSize = headerSize + payloadSize + crcSize;
+        if (buffer.size() - start < frameSize) { return start; }
+
+        const etl::span<const uint8_t> frame(buffer.data() + start, frameSize);
+        const uint16_t crc = static_cast<uint16_t>(frame[frameSize - 2] | (frame[frameSize - 1] << 8));
+        if (crc != crc16(frame.subspan(2, frameSize - 2 - crcSize))) {
+            crcErrors++;
+            start++;
+            skippedBytes++;
+            continue;
+        }
+
+        frames++;
+        dispatch(version, type, frame.subspan(headerSize, payloadSize));
+        start += frameSize;
+    }
+}
+
+void Decoder::dispatch(uint8_t version, FrameType type, etl::span<const uint8_t> payload) {
+    if (version != protocolVersion) {
+        unsupportedFrames++;
+        return;
+    }
+
+    Reader r(payload);
+    switch (type) {
+    case FrameType::sample: {
+        Sample s{};
+        s.sequence = r.u32();
+        s.timeMs = r.u32();
+        s.overruns = r.u32();
+        s.skippedFrames = r.u32();
+        s.dropped = r.u32();
+        s.freeHeap = r.u32();
+        s.minFreeHeap = r.u32();
+        s.freePsram = r.u32();
+        s.traceCount = std::min<uint8_t>(r.u8(), Sample::maxTraces);
+        for (std::size_t i = 0; i < s.traceCount; i++) {
+            TraceSummary& t = s.traces[i];
+            t.hits = r.u32();
+            t.minUs = r.u32();
+            t.maxUs = r.u32();
+            t.avgUs = r.u32();
+            t.p99Us = r.u32();
+        }
+        if (!r.ok()) {
+            unsupportedFrames++;
+            return;
+        }
+        if (onSample) { onSample(s); }
+        break;
+    }
+    case FrameType::traceNames: {
+        auto names = r.list<std::string>([&](std::string& name) { name = r.str(); });
+        if (!r.ok()) {
+            unsupportedFrames++;
+            return;
+        }
+        traceNames = std::move(names);
+        if (onTraceNames) { onTraceNames(traceNames); }
+        break;
+    }
+    case FrameType::placement: {
+        const auto entries = r.list<PlacementEntry>([&](PlacementEntry& e) {
+            e.name = r.str();
+            e.placement = r.u8();
+            e.region = r.u8();
+            e.liveBytes = r.u32();
+            e.liveCount = r.u32();
+            e.fallbacks = r.u32();
+        });
+        if (!r.ok()) {
+            unsupportedFrames++;
+            return;
+        }
+        if (onPlacement) { onPlacement(entries); }
+        break;
+    }
+    case FrameType::tasks: {
+        const auto entries = r.list<TaskEntry>([&](TaskEntry& e) {
+            e.name = r.str();
+            e.core = static_cast<int8_t>(r.u8());
+            e.priority = r.u8();
+            e.stackBytes = r.u32();
+            e.stackFreeMin = static_cast<int32_t>(r.u32());
+            e.busyUs = r.u32();
+            e.intervalUs = r.u32();
+            e.missed = r.u32();
+        });
+        if (!r.ok()) {
+            unsupportedFrames++;
+            return;
+        }
+        if (onTasks) { onTasks(entries); }
+        break;
+    }
+    case FrameType::scopedTraces: {
+        const auto entries = r.list<ScopedTraceEntry>([&](ScopedTraceEntry& e) {
+            e.name = r.str();
+            e.hits = r.u32();
+            e.minUs = r.u32();
+            e.maxUs = r.u32();
+            e.avgUs = r.u32();
+        });
+        if (!r.ok()) {
+            unsupportedFrames++;
+            return;
+        }
+        if (onScopedTraces) { onScopedTraces(entries); }
+        break;
+    }
+    case FrameType::timeline: {
+        TimelineChunk chunk;
+        const uint8_t flags = r.u8();
+        chunk.first = flags & 1;
+        chunk.last = flags & 2;
+        chunk.json = r.text();
+        if (!r.ok()) {
+            unsupportedFrames++;
+            return;
+        }
+        if (onTimelineChunk) { onTimelineChunk(chunk); }
+        break;
+    }
+    default:
+        unsupportedFrames++;
+        break;
+    }
+}
+
+TelemetryStream::TelemetryStream() = default;
+
+bool TelemetryStream::queue(etl::span<const uint8_t> frame) {
+    if (!taskStarted) { startTask(); }
+    // frames are queued whole or not at all, so the stream never holds a partial frame
+    if (frame.empty() || ring.free() < frame.size()) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ring.write(frame);
+#ifndef PIXELCLOCK_DESKTOP
+    if (task) { xTaskNotifyGive(static_cast<TaskHandle_t>(task)); }
+#endif
+    return true;
+}
+
+void TelemetryStream::waitForRoom(std::size_t bytes) {
+    if (!taskStarted) { startTask(); }
+#ifndef PIXELCLOCK_DESKTOP
+    // the telemetry task empties the ring at the UART rate
+    while (task && ring.free() < bytes) { vTaskDelay(1); }
+#else
+    (void)bytes;
+#endif
+}
+
+void TelemetryStream::publishTimeline(tracing::Timeline& timeline) {
+    TimelineChunk chunk{true, false, {}};
+    auto send = [&]() {
+        const std::size_t size = encode(chunk, scratch);
+        waitForRoom(size);
+        queue({scratch.data(), size});
+        chunk.first = false;
+        chunk.json.clear();
+    };
+
+    timeline.writeChromeTrace([&](const std::string& piece) {
+        for (std::size_t from = 0; from < piece.size();) {
+            const std::size_t n = std::min(piece.size() - from, TimelineChunk::maxSize - chunk.json.size());
+            chunk.json.append(piece, from, n);
+            from += n;
+            if (chunk.json.size() == TimelineChunk::maxSize) { send(); }
+        }
+    });
+    chunk.last = true;
+    send();
+}
+
+std::size_t TelemetryStream::drain(const std::function<void(etl::span<const uint8_t>)>& sink) {
+    const std::size_t count = ring.size();
+    if (count == 0) { return 0; }
+    const auto regions = ring.peek(count);
+    sink(regions.first);
+    if (!regions.second.empty()) { sink(regions.second); }
+    ring.skip(count);
+    return count;
+}
+
+void TelemetryStream::startTask() {
+    taskStarted = true;
+    // Started from the first publish() rather than the constructor, so it is never created during static initialisation
+    task = tasks::spawn(
+        tasks::config::telemetry,
+        [](void* o) {
+#ifndef PIXELCLOCK_DESKTOP
+            auto& stream = *static_cast<TelemetryStream*>(o);
+            tasks::TaskStats& stats = tasks::TaskMonitorSingleton::get().add(tasks::config::telemetry);
+            while (true) {
+                stats.woke(ulTaskNotifyTake(pdTRUE, portMAX_DELAY));
+                stats.workStart();
+                // Serial.write() blocks while the UART buffer is full, which only ever holds up this task
+                stream.drain([](etl::span<const uint8_t> bytes) { Serial.write(bytes.data(), bytes.size()); });
+                stats.workStop();
+            }
+#else
+            (void)o;
+#endif
+        },
+        this);
+}
+
+TelemetryStream& TelemetrySingleton::get() {
+    static TelemetryStream instance;
+    return instance;
+}
+
+} // namespace telemetry
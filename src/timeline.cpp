@@ -0,0 +1,171 @@
+/* Project Scope */
+#include "timeline.h"
+#include "FMTWrapper.h"
+#include "utility.h"
+
+/* Arduino Core */
+#include <Arduino.h>
+
+/* C++ Standard Library */
+#include <set>
+#ifdef PIXELCLOCK_DESKTOP
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#endif
+
+namespace tracing {
+
+std::atomic<bool> timelineRecording{false};
+
+namespace {
+
+uint32_t currentThread() {
+#ifdef PIXELCLOCK_DESKTOP
+    return static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#else
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle()));
+#endif
+}
+
+uint8_t currentCore() {
+#ifdef PIXELCLOCK_DESKTOP
+    return 0;
+#else
+    return static_cast<uint8_t>(xPortGetCoreID());
+#endif
+}
+
+std::string threadName(uint32_t thread) {
+#ifdef PIXELCLOCK_DESKTOP
+    return fmt::format("Thread {:08X}", thread);
+#else
+    return pcTaskGetName(reinterpret_cast<TaskHandle_t>(static_cast<uintptr_t>(thread)));
+#endif
+}
+
+std::string escapeJson(const char* s) {
+    std::string out;
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') { out += '\\'; }
+        out += *s;
+    }
+    return out;
+}
+
+} // namespace
+
+Timeline::Timeline() = default;
+
+void Timeline::start() { active.store(true, std::memory_order_relaxed); }
+
+void Timeline::stop() { active.store(false, std::memory_order_relaxed); }
+
+void Timeline::record(const char* name, TimelineEvent::Phase phase) {
+    if (!recording()) { return; }
+    const TimelineEvent event{name, static_cast<uint32_t>(micros()), currentThread(), currentCore(), phase};
+
+    const uint32_t n = next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[n & (capacity - 1)];
+    slot.tag.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint32_t words[wordCount]{};
+    std::memcpy(words, &event, sizeof(event));
+    for (std::size_t i = 0; i < wordCount; i++) { slot.words[i].store(words[i], std::memory_order_relaxed); }
+
+    slot.tag.store(n + 1, std::memory_order_release);
+}
+
+void Timeline::forEachEvent(const std::function<void(const TimelineEvent&)>& visit) const {
+    const uint32_t end = next.load(std::memory_order_acquire);
+    const uint32_t begin = end > capacity ? end - static_cast<uint32_t>(capacity) : 0;
+    for (uint32_t n = begin; n != end; n++) {
+        const Slot& slot = slots[n & (capacity - 1)];
+        if (slot.tag.load(std::memory_order_acquire) != n + 1) { continue; }
+
+        uint32_t words[wordCount];
+        for (std::size_t i = 0; i < wordCount; i++) { words[i] = slot.words[i].load(std::memory_order_relaxed); }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // skip the event if it was overwritten while being copied
+        if (slot.tag.load(std::memory_order_relaxed) != n + 1) { continue; }
+
+        TimelineEvent event;
+        std::memcpy(&event, words, sizeof(event));
+        visit(event);
+    }
+}
+
+void Timeline::writeChromeTrace(const std::function<void(const std::string&)>& write) {
+    const bool wasRecording = recording();
+    stop();
+
+    write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    bool haveOrigin = false;
+    uint32_t originUs = 0;
+    std::set<uint32_t> threads;
+    forEachEvent([&](const TimelineEvent& e) {
+        if (!haveOrigin) {
+            originUs = e.timeUs;
+            haveOrigin = true;
+        }
+        threads.insert(e.thread);
+        // relative to the first event, so the times survive micros() wrapping
+        write(fmt::format(
+            "{}{{\"name\":\"{}\",\"ph\":\"{}\",\"ts\":{},\"pid\":0,\"tid\":{},\"args\":{{\"core\":{}}}}}",
+            first ? "" : ",\n",
+            escapeJson(e.name),
+            e.phase == TimelineEvent::Phase::begin ? 'B' : 'E',
+            e.timeUs - originUs,
+            e.thread,
+            e.core));
+        first = false;
+    });
+    for (uint32_t thread : threads) {
+        write(fmt::format(
+            "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+            first ? "" : ",\n",
+            thread,
+            escapeJson(threadName(thread).c_str())));
+        first = false;
+    }
+    write("\n]}\n");
+
+    if (wasRecording) { start(); }
+}
+
+Timeline& TimelineSingleton::get() {
+    static Timeline instance;
+    return instance;
+}
+
+void startTimeline() {
+    TimelineSingleton::get().start();
+    timelineRecording.store(true, std::memory_order_relaxed);
+}
+
+void stopTimeline() {
+    timelineRecording.store(false, std::memory_order_relaxed);
+    TimelineSingleton::get().stop();
+}
+
+#ifdef PIXELCLOCK_DESKTOP
+void updateTimelineFile() {
+    static const char* path = std::getenv("PIXELCLOCK_TRACE_FILE");
+    if (!path) { return; }
+    if (!timelineRecording.load(std::memory_order_relaxed)) {
+        startTimeline();
+        return;
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        printing::print(fmt::format("Could not write the timeline to {}\n", path));
+        return;
+    }
+    TimelineSingleton::get().writeChromeTrace([&](const std::string& piece) { file << piece; });
+}
+#endif
+
+} // namespace tracing
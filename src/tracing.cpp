@@ -0,0 +1,80 @@
+/* Project Scope */
+#include "tracing.h"
+#include "FMTWrapper.h"
+#include "utility.h"
+
+/* C++ Standard Library */
+#ifdef PIXELCLOCK_DESKTOP
+#include <chrono>
+#include <thread>
+#endif
+
+namespace tracing {
+
+namespace {
+
+std::atomic<TracePoint*> head{nullptr};
+
+} // namespace
+
+float cyclesPerMicrosecond() {
+#if !defined(PIXELCLOCK_DESKTOP)
+    return static_cast<float>(ESP.getCpuFreqMHz());
+#elif defined(PIXELCLOCK_TRACING_RDTSC)
+    // the TSC rate is constant on anything recent, so measure it once against the steady clock
+    static const float rate = []() {
+        using namespace std::chrono;
+        const auto from = steady_clock::now();
+        const uint64_t fromCycles = __rdtsc();
+        std::this_thread::sleep_for(milliseconds(10));
+        const uint64_t elapsedCycles = __rdtsc() - fromCycles;
+        const auto elapsedUs = duration_cast<duration<float, std::micro>>(steady_clock::now() - from).count();
+        return elapsedCycles / elapsedUs;
+    }();
+    return rate;
+#else
+    return 1000.0f; // nanoseconds
+#endif
+}
+
+TracePoint::TracePoint(const char* name) : name(name) {
+    next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+TracePoint* firstTracePoint() { return head.load(std::memory_order_acquire); }
+
+std::vector<TracePointReport> takeReport() {
+    const float rate = cyclesPerMicrosecond();
+    auto toMicros = [&](double c) { return static_cast<uint32_t>(c / rate + 0.5); };
+
+    std::vector<TracePointReport> report;
+    for (TracePoint* p = firstTracePoint(); p; p = p->getNext()) {
+        const uint32_t hits = p->getHits();
+        report.push_back(
+            {p->getName(),
+             hits,
+             toMicros(p->getMin()),
+             toMicros(p->getMax()),
+             hits ? toMicros(double(p->getSum()) / hits) : 0});
+        p->reset();
+    }
+    return report;
+}
+
+void printReport() {
+    using namespace printing;
+
+    constexpr int nameWidth = 30;
+    constexpr int fieldWidth = 15;
+
+    auto printRow = [&](auto... fields) {
+        print(fmt::format("{2:<{0}}{3:<{1}}{4:<{1}}{5:<{1}}{6:<{1}}\n", nameWidth, fieldWidth, fields...));
+    };
+
+    printCentred("Scoped Traces", headingWidth);
+    printRow("", "Hits", "Min (us)", "Max (us)", "Avg (us)");
+    for (const TracePointReport& p : takeReport()) { printRow(p.name, p.hits, p.minUs, p.maxUs, p.avgUs); }
+}
+
+} // namespace tracing
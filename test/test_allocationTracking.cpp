@@ -0,0 +1,70 @@
+/* Project Scope */
+#include "allocationTracking.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <cstdint>
+#include <memory>
+
+TEST(AllocationTrackingTestSuite, CountsAgainstInnermostTag) {
+    const auto modeBefore = alloc::getCounters(alloc::Subsystem::mode);
+    const auto effectBefore = alloc::getCounters(alloc::Subsystem::effect);
+
+    {
+        alloc::ScopeTag modeTag(alloc::Subsystem::mode);
+        auto a = std::make_unique<int>(1);
+        {
+            alloc::ScopeTag effectTag(alloc::Subsystem::effect);
+            auto b = std::make_unique<int[]>(10);
+        }
+    }
+
+    const auto modeAfter = alloc::getCounters(alloc::Subsystem::mode);
+    const auto effectAfter = alloc::getCounters(alloc::Subsystem::effect);
+    EXPECT_EQ(1u, modeAfter.allocations - modeBefore.allocations);
+    EXPECT_EQ(1u, modeAfter.frees - modeBefore.frees);
+    EXPECT_EQ(sizeof(int), modeAfter.bytes - modeBefore.bytes);
+    EXPECT_EQ(1u, effectAfter.allocations - effectBefore.allocations);
+    EXPECT_EQ(10 * sizeof(int), effectAfter.bytes - effectBefore.bytes);
+}
+
+TEST(AllocationTrackingTestSuite, FreesCountAgainstAllocatingSubsystem) {
+    const auto audioBefore = alloc::getCounters(alloc::Subsystem::audio);
+    const auto displayBefore = alloc::getCounters(alloc::Subsystem::display);
+
+    std::unique_ptr<int> p;
+    {
+        alloc::ScopeTag audioTag(alloc::Subsystem::audio);
+        p = std::make_unique<int>(1);
+    }
+    {
+        alloc::ScopeTag displayTag(alloc::Subsystem::display);
+        p.reset();
+    }
+
+    const auto audioAfter = alloc::getCounters(alloc::Subsystem::audio);
+    const auto displayAfter = alloc::getCounters(alloc::Subsystem::display);
+    EXPECT_EQ(1u, audioAfter.allocations - audioBefore.allocations);
+    EXPECT_EQ(1u, audioAfter.frees - audioBefore.frees);
+    EXPECT_EQ(0u, displayAfter.frees - displayBefore.frees);
+}
+
+TEST(AllocationTrackingTestSuite, TracksOverAlignedAllocations) {
+    struct alignas(64) CacheLine {
+        uint8_t bytes[64];
+    };
+    const auto before = alloc::getCounters(alloc::Subsystem::effect);
+    {
+        alloc::ScopeTag effectTag(alloc::Subsystem::effect);
+        auto line = std::make_unique<CacheLine>();
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(line.get()) % 64);
+        auto lines = std::make_unique<CacheLine[]>(3);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(lines.get()) % 64);
+    }
+    const auto after = alloc::getCounters(alloc::Subsystem::effect);
+    EXPECT_EQ(2u, after.allocations - before.allocations);
+    EXPECT_EQ(2u, after.frees - before.frees);
+    EXPECT_EQ(4 * sizeof(CacheLine), after.bytes - before.bytes);
+}
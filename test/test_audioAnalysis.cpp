@@ -0,0 +1,125 @@
+/* Project Scope */
+#include "audio/analysis.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Interleaved stereo block with a different tone and level on each channel
+std::vector<int16_t> stereoBlock(float leftAmplitude, float rightAmplitude) {
+    std::vector<int16_t> block(audioWindowSamples);
+    for (std::size_t i = 0; i < block.size() / 2; i++) {
+        float t = static_cast<float>(i) / fftSampleFreq;
+        block[2 * i] = static_cast<int16_t>(leftAmplitude * std::sin(6.2831853f * 440.0f * t));
+        block[2 * i + 1] = static_cast<int16_t>(rightAmplitude * std::sin(6.2831853f * 1250.0f * t));
+    }
+    return block;
+}
+
+} // namespace
+
+TEST(AudioAnalysisTestSuite, MixDownMatchesReference) {
+    // signed input, including full scale negative samples and a right channel that cancels the left
+    std::vector<int16_t> block(audioWindowSamples);
+    double sumLeft = 0;
+    double sumRight = 0;
+    for (std::size_t f = 0; f < block.size() / 2; f++) {
+        const int16_t left = f % 3 == 0 ? -32768 : static_cast<int16_t>(int(f * 37) % 20001 - 10000);
+        const int16_t right = f % 5 == 0 ? static_cast<int16_t>(-left / 2) : static_cast<int16_t>(-(int(f) % 7000));
+        block[2 * f] = left;
+        block[2 * f + 1] = right;
+        sumLeft += double(left) * left;
+        sumRight += double(right) * right;
+    }
+    const double frames = block.size() / 2;
+    const float expectedLeft = static_cast<float>(20 * std::log10(std::sqrt(sumLeft / frames) / 32768));
+    const float expectedRight = static_cast<float>(20 * std::log10(std::sqrt(sumRight / frames) / 32768));
+
+    std::vector<float> mono(fftSamples);
+    std::vector<int16_t> monoFixed(fftSamples);
+    auto volume = analysis::mixDown(block, etl::span<float>(mono.data(), mono.size()));
+    auto volumeFixed = analysis::mixDown(block, etl::span<int16_t>(monoFixed.data(), monoFixed.size()));
+
+    for (std::size_t f = 0; f < mono.size(); f++) {
+        const int32_t sum = int32_t(block[2 * f]) + block[2 * f + 1];
+        ASSERT_EQ(mono[f], sum / 2.0f) << f;
+        ASSERT_EQ(monoFixed[f], sum >> 1) << f;
+    }
+    EXPECT_NEAR(volume.left, expectedLeft, 1e-3f);
+    EXPECT_NEAR(volume.right, expectedRight, 1e-3f);
+    EXPECT_NEAR(volumeFixed.left, expectedLeft, 0.05f);
+    EXPECT_NEAR(volumeFixed.right, expectedRight, 0.05f);
+}
+
+TEST(AudioAnalysisTestSuite, MixDownVolumeOfSines) {
+    // a sine of peak amplitude A has an RMS of A / sqrt(2): -9.03 dBFS at half scale
+    for (float amplitude : {30000.0f, 3000.0f, 300.0f}) {
+        auto block = stereoBlock(amplitude, amplitude / 4);
+        std::vector<float> mono(fftSamples);
+        std::vector<int16_t> monoFixed(fftSamples);
+        auto volume = analysis::mixDown(block, etl::span<float>(mono.data(), mono.size()));
+        auto volumeFixed = analysis::mixDown(block, etl::span<int16_t>(monoFixed.data(), monoFixed.size()));
+
+        const float expected = 20 * std::log10(amplitude / std::sqrt(2.0f) / 32768);
+        EXPECT_NEAR(volume.left, expected, 0.05f) << amplitude;
+        // the quarter amplitude right channel loses a little to truncation when quiet
+        EXPECT_NEAR(volume.right, expected - 12.04f, 0.1f) << amplitude;
+        EXPECT_NEAR(volume.left, volumeFixed.left, 0.05f) << amplitude;
+        EXPECT_NEAR(volume.right, volumeFixed.right, 0.05f) << amplitude;
+    }
+}
+
+TEST(AudioAnalysisTestSuite, FixedPointSpectrumMatchesFloat) {
+    auto block = stereoBlock(12000.0f, 6000.0f);
+
+    std::vector<float> input(fftSamples, 0);
+    std::vector<int16_t> inputFixed(fftSamples, 0);
+    analysis::mixDown(block, etl::span<int16_t>(inputFixed.data(), inputFixed.size()));
+    std::copy(inputFixed.begin(), inputFixed.end(), input.begin());
+
+    RealFFT fft(fftSamples);
+    RealFFTQ15 fftFixed(fftSamples);
+    std::vector<float> mags(fftSamples / 2);
+    std::vector<uint32_t> magsFixed(fftSamples / 2);
+    fft.magnitudes(input, mags);
+    fftFixed.magnitudes(inputFixed, magsFixed);
+
+    const float prevMax = 1000;
+    analysis::Spectrum spectrum;
+    analysis::Spectrum spectrumFixed;
+    analysis::binSpectrum(etl::span<const float>(mags.data(), mags.size()), prevMax, spectrum);
+    analysis::binSpectrum(etl::span<const uint32_t>(magsFixed.data(), magsFixed.size()), prevMax, spectrumFixed);
+
+    float peak = *std::max_element(spectrum.begin(), spectrum.end());
+    EXPECT_GT(peak, 0);
+    for (std::size_t b = 0; b < spectrum.size(); b++) { EXPECT_NEAR(spectrum[b], spectrumFixed[b], peak * 0.01f) << b; }
+}
+
+TEST(AudioAnalysisTestSuite, SplitViewMatchesContiguous) {
+    auto block = stereoBlock(12000.0f, 3000.0f);
+    etl::span<const int16_t> all(block.data(), block.size());
+    analysis::SampleView split(all.first(1000), all.subspan(1000));
+
+    std::vector<int16_t> mono(fftSamples);
+    std::vector<int16_t> monoSplit(fftSamples);
+    auto volume = analysis::mixDown(block, etl::span<int16_t>(mono.data(), mono.size()));
+    auto volumeSplit = analysis::mixDown(split, etl::span<int16_t>(monoSplit.data(), monoSplit.size()));
+    EXPECT_FLOAT_EQ(volume.left, volumeSplit.left);
+    EXPECT_FLOAT_EQ(volume.right, volumeSplit.right);
+    EXPECT_EQ(mono, monoSplit);
+}
+
+TEST(AudioAnalysisTestSuite, PerHopAlphaMatchesOneWindowStep) {
+    // a window's worth of hops moves the average as far as a single update did when each entry was a whole window
+    utility::EMA perHop(analysis::perHopAlpha(0.8f));
+    perHop.update(0);
+    for (int i = 0; i < audioHopsPerWindow; i++) { perHop.update(10); }
+    EXPECT_NEAR(perHop.getValue(), 0.8f * 10, 1e-4);
+}
@@ -0,0 +1,95 @@
+/* Project Scope */
+#include "audio/analyzer.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Interleaved stereo 440 Hz tone
+std::vector<int16_t> tone(std::size_t frames, float amplitude) {
+    std::vector<int16_t> samples(frames * 2);
+    for (std::size_t i = 0; i < frames; i++) {
+        const int16_t s = static_cast<int16_t>(amplitude * std::sin(6.2831853 * 440 * i / fftSampleFreq));
+        samples[2 * i] = s;
+        samples[2 * i + 1] = s;
+    }
+    return samples;
+}
+
+struct Pipeline {
+    std::array<int16_t, 16384> storage;
+    SpscRing<int16_t> ring{storage.data(), storage.size()};
+    BlockTimestamps timestamps;
+    AudioHistory history;
+    analysis::AudioAnalyzer analyzer;
+};
+
+} // namespace
+
+TEST(AudioAnalyzerTestSuite, ProcessSlidesOneHopPerWindow) {
+    auto p = std::make_unique<Pipeline>();
+    const auto samples = tone(fftSamples + 3 * audioHopFrames + 100, 10000);
+    p->timestamps.written(samples.size(), 1234);
+    p->ring.write({samples.data(), samples.size()});
+
+    p->analyzer.process(p->ring, p->timestamps, p->history, 0);
+
+    // four windows fit, and what is left is less than a window
+    EXPECT_EQ(p->history.getPublishedCount(), 4u);
+    EXPECT_EQ(p->ring.size(), static_cast<std::size_t>(fftSamples + 100) * 2 - audioHopSamples);
+    EXPECT_EQ(p->history.latest().captureTimeUs, 1234u);
+
+    // the first published window matches analysing the same samples directly
+    auto direct = std::make_unique<analysis::AudioAnalyzer>();
+    const AudioCharacteristics expected =
+        direct->analyse(etl::span<const int16_t>(samples.data(), audioWindowSamples), 0);
+    AudioCharacteristics first;
+    ASSERT_TRUE(p->history.read(3, first));
+    EXPECT_EQ(first.volumeLeft, expected.volumeLeft);
+    EXPECT_TRUE(first.spectrum == expected.spectrum);
+}
+
+TEST(AudioAnalyzerTestSuite, WindowsInOneBatchAreStampedByOffset) {
+    // a tone starting after some silence, all processed in one batch
+    auto p = std::make_unique<Pipeline>();
+    auto samples = tone(fftSamples + 12 * audioHopFrames, 10000);
+    std::fill_n(samples.begin(), (fftSamples + 4 * audioHopFrames) * 2, 0);
+    p->timestamps.written(samples.size(), 0);
+    p->ring.write({samples.data(), samples.size()});
+
+    const uint32_t timeMs = 5000;
+    ASSERT_TRUE(p->analyzer.process(p->ring, p->timestamps, p->history, timeMs));
+
+    // the onset lands after the first window, and no event is stamped later than the newest window
+    const uint32_t firstWindowMs = timeMs - 12 * audioHopFrames * 1000 / fftSampleFreq;
+    analysis::BeatEvent event{};
+    std::size_t onsets = 0;
+    while (p->analyzer.getBeatEvents().read({&event, 1}) == 1) {
+        EXPECT_LE(event.timeMs, timeMs);
+        if (event.type == analysis::BeatEvent::Type::onset) {
+            onsets++;
+            EXPECT_GT(event.timeMs, firstWindowMs);
+            EXPECT_LT(event.timeMs, timeMs);
+        }
+    }
+    EXPECT_GE(onsets, 1u);
+}
+
+TEST(AudioAnalyzerTestSuite, AutoGainSettlesAcrossLevels) {
+    // the auto-gain scales the loudest display bin of a steady tone towards the same level, whatever its amplitude
+    for (float amplitude : {2000.0f, 20000.0f}) {
+        auto analyzer = std::make_unique<analysis::AudioAnalyzer>();
+        const auto samples = tone(fftSamples, amplitude);
+        AudioCharacteristics c{};
+        for (int i = 0; i < 2 * audioHistorySize; i++) { c = analyzer->analyse(samples, 0); }
+        EXPECT_NEAR(*std::max_element(c.spectrum.begin(), c.spectrum.end()), 6000, 1) << amplitude;
+    }
+}
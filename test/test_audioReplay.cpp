@@ -0,0 +1,92 @@
+/* Project Scope */
+#include "audio/replay.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// One second of stereo 1 kHz sine, left at -6 dBFS peak and right at -12 dBFS peak
+std::string writeTestWav() {
+    const std::string path = (std::filesystem::temp_directory_path() / "pixelclock_replay_test.wav").string();
+    const uint32_t frames = fftSampleFreq;
+    const uint32_t dataBytes = frames * 4;
+
+    std::ofstream out(path, std::ios::binary);
+    auto u16 = [&](uint16_t v) { out.put(char(v & 0xff)).put(char(v >> 8)); };
+    auto u32 = [&](uint32_t v) {
+        u16(uint16_t(v & 0xffff));
+        u16(uint16_t(v >> 16));
+    };
+    out << "RIFF";
+    u32(36 + dataBytes);
+    out << "WAVEfmt ";
+    u32(16);
+    u16(1);                 // PCM
+    u16(2);                 // channels
+    u32(fftSampleFreq);     // sample rate
+    u32(fftSampleFreq * 4); // byte rate
+    u16(4);                 // block align
+    u16(16);                // bits per sample
+    out << "data";
+    u32(dataBytes);
+    for (uint32_t i = 0; i < frames; i++) {
+        const double s = std::sin(6.283185307179586 * 1000 * i / fftSampleFreq);
+        u16(uint16_t(int16_t(16384 * s)));
+        u16(uint16_t(int16_t(8192 * s)));
+    }
+    return path;
+}
+
+std::vector<AudioCharacteristics> replay(const std::string& path) {
+    auto audio =
+        std::make_unique<AudioReplay>(path, AudioReplay::Pacing::asFastAsPossible, AudioReplay::Clock::file);
+    audio->begin();
+    while (!audio->finished()) { audio->update(); }
+
+    const AudioHistory& history = audio->getAudioCharacteristicsHistory();
+    std::vector<AudioCharacteristics> out(history.size());
+    for (std::size_t age = 0; age < out.size(); age++) { EXPECT_TRUE(history.read(age, out[age])); }
+    EXPECT_EQ(history.getPublishedCount(), out.size());
+    return out;
+}
+
+} // namespace
+
+TEST(AudioReplayTestSuite, GoldenToneAnalysis) {
+    const std::string path = writeTestWav();
+    const auto first = replay(path);
+    const auto second = replay(path);
+    std::remove(path.c_str());
+
+    // one window per 512-frame hop that fits in the file
+    ASSERT_EQ(first.size(), 83u);
+
+    const AudioCharacteristics& latest = first.front();
+    // the window ends with the 86th 512-frame block, timestamped from its position in the file
+    EXPECT_EQ(latest.captureTimeUs, 998458u);
+    // RMS of a sine is its peak / sqrt(2)
+    EXPECT_NEAR(latest.volumeLeft, -9.03f, 0.05f);
+    EXPECT_NEAR(latest.volumeRight, -15.05f, 0.05f);
+    // 1 kHz falls in the display bin covering 828 - 1066 Hz
+    EXPECT_EQ(std::max_element(latest.spectrum.begin(), latest.spectrum.end()) - latest.spectrum.begin(), 5);
+
+    // replaying as fast as possible is deterministic
+    ASSERT_EQ(first.size(), second.size());
+    for (std::size_t i = 0; i < first.size(); i++) {
+        EXPECT_EQ(first[i].captureTimeUs, second[i].captureTimeUs);
+        EXPECT_EQ(first[i].volumeLeft, second[i].volumeLeft);
+        EXPECT_EQ(first[i].volumeRight, second[i].volumeRight);
+        EXPECT_EQ(first[i].spectrumMax, second[i].spectrumMax);
+        EXPECT_TRUE(first[i].spectrum == second[i].spectrum) << i;
+    }
+}
@@ -0,0 +1,126 @@
+/* Project Scope */
+#include "audio/beatTracker.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <array>
+#include <cmath>
+#include <vector>
+
+using analysis::BeatEvent;
+
+namespace {
+
+constexpr float chunksPerSecond = 44100.0f / 512;
+
+// Feeds 'seconds' of a click track at 'bpm' (a broadband hit decaying over a few chunks, over a quiet floor) and
+// returns the events produced
+std::vector<BeatEvent> runClickTrack(analysis::BeatTracker& tracker, float bpm, float seconds) {
+    std::vector<BeatEvent> out;
+    const int chunks = static_cast<int>(seconds * chunksPerSecond);
+    for (int i = 0; i < chunks; i++) {
+        const float t = i / chunksPerSecond;
+        const float sinceBeat = std::fmod(t, 60 / bpm);
+        std::array<float, 17> spectrum;
+        spectrum.fill(10 + 5000 * std::exp(-sinceBeat * 30));
+        tracker.update({spectrum.data(), spectrum.size()}, static_cast<uint32_t>(t * 1000));
+
+        BeatEvent e;
+        while (tracker.getEvents().read({&e, 1}) == 1) { out.push_back(e); }
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(BeatTrackerTestSuite, TracksClickTrackTempo) {
+    for (float bpm : {100.0f, 128.0f}) {
+        analysis::BeatTracker tracker(chunksPerSecond);
+        auto events = runClickTrack(tracker, bpm, 20);
+        EXPECT_NEAR(tracker.getBpm(), bpm, 1.5f);
+
+        int onsets = 0;
+        std::vector<uint32_t> beatTimes;
+        for (const auto& e : events) {
+            if (e.type == BeatEvent::Type::onset) { onsets++; }
+            if (e.type == BeatEvent::Type::beat) { beatTimes.push_back(e.timeMs); }
+        }
+        // one onset per click
+        EXPECT_NEAR(onsets, 20 * bpm / 60, 2);
+
+        // once locked, beats are a beat period apart and land on the clicks
+        ASSERT_GT(beatTimes.size(), 10u);
+        const float periodMs = 60000 / bpm;
+        for (std::size_t i = beatTimes.size() - 5; i < beatTimes.size(); i++) {
+            EXPECT_NEAR(beatTimes[i] - beatTimes[i - 1], periodMs, 25) << bpm;
+            float offset = std::fmod(static_cast<float>(beatTimes[i]), periodMs);
+            EXPECT_LT(std::min(offset, periodMs - offset), 40) << bpm;
+        }
+    }
+}
+
+TEST(BeatTrackerTestSuite, BeatSyncFillsFrameContext) {
+    std::array<BeatEvent, 8> storage;
+    analysis::BeatEventQueue queue(storage.data(), storage.size());
+    analysis::BeatSync sync;
+
+    const BeatEvent onset{BeatEvent::Type::onset, 990, 2.5f, 120, 0.9f};
+    const BeatEvent beat{BeatEvent::Type::beat, 1000, 0.8f, 120, 0};
+    queue.write({&onset, 1});
+    queue.write({&beat, 1});
+
+    FrameContext frame{};
+    frame.timeMs = 1125;
+    sync.apply(queue, frame);
+    EXPECT_EQ(frame.beats, 1);
+    EXPECT_EQ(frame.onsets, 1);
+    EXPECT_FLOAT_EQ(frame.onsetStrength, 2.5f);
+    EXPECT_FLOAT_EQ(frame.bpm, 120);
+    EXPECT_NEAR(frame.beatPhase, 0.25f, 1e-4);
+
+    // no new events: counts reset, phase keeps extrapolating
+    frame.timeMs = 1750;
+    sync.apply(queue, frame);
+    EXPECT_EQ(frame.beats, 0);
+    EXPECT_EQ(frame.onsets, 0);
+    EXPECT_NEAR(frame.beatPhase, 0.5f, 1e-4);
+}
+
+TEST(BeatTrackerTestSuite, BeatSyncForgetsTempoWithoutBeats) {
+    std::array<BeatEvent, 8> storage;
+    analysis::BeatEventQueue queue(storage.data(), storage.size());
+    analysis::BeatSync sync;
+
+    const BeatEvent beat{BeatEvent::Type::beat, 1000, 0.8f, 120, 0};
+    queue.write({&beat, 1});
+    FrameContext frame{};
+    frame.timeMs = 1000;
+    sync.apply(queue, frame);
+    EXPECT_FLOAT_EQ(frame.bpm, 120);
+
+    // within a few beat periods the tempo is kept, past them it reverts to unknown
+    frame.timeMs = 1000 + 3 * 500;
+    sync.apply(queue, frame);
+    EXPECT_FLOAT_EQ(frame.bpm, 120);
+    frame.timeMs = 1000 + 5 * 500 + 100;
+    sync.apply(queue, frame);
+    EXPECT_FLOAT_EQ(frame.bpm, 0);
+    EXPECT_FLOAT_EQ(frame.beatPhase, 0);
+}
+
+TEST(BeatTrackerTestSuite, BeatSyncBeatAfterFrameIsPhaseZero) {
+    std::array<BeatEvent, 8> storage;
+    analysis::BeatEventQueue queue(storage.data(), storage.size());
+    analysis::BeatSync sync;
+
+    const BeatEvent beat{BeatEvent::Type::beat, 1010, 0.8f, 120, 0};
+    queue.write({&beat, 1});
+    FrameContext frame{};
+    frame.timeMs = 1000;
+    sync.apply(queue, frame);
+    EXPECT_EQ(frame.beats, 1);
+    EXPECT_FLOAT_EQ(frame.bpm, 120);
+    EXPECT_FLOAT_EQ(frame.beatPhase, 0);
+}
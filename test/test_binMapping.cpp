@@ -0,0 +1,69 @@
+/* Project Scope */
+#include "audio/binMapping.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace analysis;
+
+namespace {
+
+constexpr double binHz = 44100.0 / 2048;
+constexpr std::size_t fftBins = 1024;
+
+constexpr auto melEdges = makeBinEdges<17>(BinSpacing::mel, 40, 8000);
+constexpr std::size_t melEntries = countBinMapEntries(melEdges, binHz, fftBins);
+constexpr auto melMap = makeBinMap<melEntries>(melEdges, binHz, fftBins);
+
+} // namespace
+
+TEST(BinMappingTestSuite, ScalesRoundTrip) {
+    for (BinSpacing spacing : {BinSpacing::linear, BinSpacing::log, BinSpacing::mel, BinSpacing::bark}) {
+        for (double hz : {40.0, 440.0, 3000.0, 16000.0}) {
+            EXPECT_NEAR(fromScale(spacing, toScale(spacing, hz)), hz, hz * 1e-9);
+        }
+    }
+    EXPECT_NEAR(toScale(BinSpacing::log, 1000), std::log(1000.0), 1e-12);
+    EXPECT_NEAR(toScale(BinSpacing::mel, 1000), 1000, 0.1);
+}
+
+TEST(BinMappingTestSuite, EdgesWidenWithFrequency) {
+    for (BinSpacing spacing : {BinSpacing::log, BinSpacing::mel, BinSpacing::bark}) {
+        auto edges = makeBinEdges<17>(spacing, 40, 8000);
+        EXPECT_EQ(edges.front(), 40);
+        EXPECT_EQ(edges.back(), 8000);
+        for (std::size_t b = 1; b + 1 < edges.size(); b++) {
+            EXPECT_GT(edges[b + 1] - edges[b], edges[b] - edges[b - 1]);
+        }
+    }
+}
+
+TEST(BinMappingTestSuite, OverlapsCoverEachFFTBinOnce) {
+    // undo the per-display-bin normalisation to recover each FFT bin's overlap fractions, which must add up to one for
+    // FFT bins wholly inside the display range
+    std::vector<double> covered(fftBins, 0);
+    for (const BinWeight& w : melMap) {
+        const double width = (melEdges[w.displayBin + 1] - melEdges[w.displayBin]) / binHz;
+        covered[w.fftBin] += w.weight * std::sqrt(std::max(width, 1.0));
+    }
+    for (std::size_t k = 0; k < fftBins; k++) {
+        if ((k - 0.5) * binHz >= melEdges.front() && (k + 0.5) * binHz <= melEdges.back()) {
+            EXPECT_NEAR(covered[k], 1, 1e-5) << k;
+        } else if (k * binHz > melEdges.back() + binHz) {
+            EXPECT_EQ(covered[k], 0) << k;
+        }
+    }
+
+    // a tone lands in the display bin that contains its frequency
+    for (const BinWeight& w : melMap) {
+        if (w.fftBin == 100) {
+            const double hz = 100 * binHz;
+            EXPECT_TRUE(melEdges[w.displayBin] <= hz && hz < melEdges[w.displayBin + 1]);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+/* Project Scope */
+#include "audio/blockTimestamps.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+TEST(BlockTimestampsTestSuite, FindsBlockHoldingNewestSample) {
+    BlockTimestamps stamps;
+    stamps.written(100, 1000); // samples [0, 100)
+    stamps.written(100, 2000); // samples [100, 200)
+    stamps.written(100, 3000); // samples [200, 300)
+
+    EXPECT_EQ(stamps.arrivalOf(100), 1000u);
+    EXPECT_EQ(stamps.arrivalOf(150), 2000u);
+
+    // slide the window forward: the newest sample moves into the third block
+    stamps.consumed(50);
+    EXPECT_EQ(stamps.arrivalOf(150), 2000u);
+    EXPECT_EQ(stamps.arrivalOf(200), 3000u);
+    stamps.consumed(100);
+    EXPECT_EQ(stamps.arrivalOf(150), 3000u);
+
+    // with no stamp for newer samples, the newest stamp seen is reported
+    EXPECT_EQ(stamps.arrivalOf(500), 3000u);
+}
+
+TEST(BlockTimestampsTestSuite, EmptyWritesAreNotStamped) {
+    BlockTimestamps stamps;
+    stamps.written(100, 1000);
+    // a full sample ring makes the producer write nothing, and those calls must not crowd out real stamps
+    for (int i = 0; i < 100; i++) { stamps.written(0, 1500); }
+    stamps.written(100, 2000);
+
+    EXPECT_EQ(stamps.arrivalOf(100), 1000u);
+    EXPECT_EQ(stamps.arrivalOf(150), 2000u);
+}
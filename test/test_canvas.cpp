@@ -28,3 +28,30 @@ TEST(CanvasTestSuite, CanvasBasics) {
     c.setXY(1, 1, flm::CRGB::Blue);
     EXPECT_EQ(c.getXY(1, 1), flm::CRGB::Blue);
 }
+
+TEST(CanvasTestSuite, CanvasFromFrameArena) {
+
+    FrameArena arena(1024);
+
+    Canvas c(10, 4, arena);
+    EXPECT_EQ(40, c.getSize());
+    EXPECT_EQ(c.getXY(0, 0), flm::CRGB::Black);
+    EXPECT_TRUE(arena.owns(&c[0]));
+    EXPECT_GE(arena.getUsed(), 40 * sizeof(flm::CRGB));
+
+    // copies are allocated normally, so they can outlive the frame
+    Canvas copy(c);
+    EXPECT_FALSE(arena.owns(&copy[0]));
+
+    Canvas assigned(10, 4);
+    assigned = Canvas(10, 4, arena);
+    EXPECT_FALSE(arena.owns(&assigned[0]));
+
+    arena.reset();
+    EXPECT_EQ(0, arena.getUsed());
+    EXPECT_GE(arena.getHighWaterMark(), 40 * sizeof(flm::CRGB));
+
+    // requests that do not fit fall back to the heap
+    Canvas large(100, 100, arena);
+    EXPECT_FALSE(arena.owns(&large[0]));
+}
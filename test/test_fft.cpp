@@ -0,0 +1,100 @@
+/* Project Scope */
+#include "audio/fft.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr double twoPi = 6.28318530717958647692;
+
+// Reference: DC removal, Hamming window and a direct O(N^2) DFT, in double precision
+std::vector<double> naiveMagnitudes(const std::vector<float>& input) {
+    const std::size_t n = input.size();
+    double mean = 0;
+    for (float x : input) { mean += x; }
+    mean /= n;
+
+    std::vector<double> mags(n / 2);
+    for (std::size_t k = 0; k < n / 2; k++) {
+        std::complex<double> sum = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            double w = 0.54 - 0.46 * std::cos(twoPi * i / (n - 1));
+            sum += (input[i] - mean) * w * std::polar(1.0, -twoPi * k * i / n);
+        }
+        mags[k] = std::abs(sum);
+    }
+    return mags;
+}
+
+std::vector<float> testSignal(std::size_t n) {
+    std::vector<float> signal(n);
+    uint32_t lcg = 12345;
+    for (std::size_t i = 0; i < n; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        float noise = static_cast<float>(lcg >> 16) / 65536.0f - 0.5f;
+        signal[i] = 300.0f + 8000.0f * std::sin(float(twoPi) * 37.0f * i / n) +
+                    2000.0f * std::cos(float(twoPi) * 200.5f * i / n) + 500.0f * noise;
+    }
+    return signal;
+}
+
+} // namespace
+
+TEST(FFTTestSuite, MatchesNaiveDFT) {
+    for (std::size_t n : {8u, 64u, 512u}) {
+        RealFFT fft(n);
+        auto input = testSignal(n);
+        std::vector<float> mags(n / 2);
+        fft.magnitudes(input, mags);
+
+        auto expected = naiveMagnitudes(input);
+        double peak = *std::max_element(expected.begin(), expected.end());
+        for (std::size_t k = 0; k < n / 2; k++) { EXPECT_NEAR(expected[k], mags[k], peak * 1e-4) << n << " " << k; }
+    }
+}
+
+TEST(FFTTestSuite, SinePeaksInItsBin) {
+    constexpr std::size_t n = 2048;
+    RealFFT fft(n);
+    std::vector<float> input(n);
+    for (std::size_t i = 0; i < n; i++) { input[i] = 10000.0f * std::sin(float(twoPi) * 100.0f * i / n); }
+    std::vector<float> mags(n / 2);
+    fft.magnitudes(input, mags);
+
+    EXPECT_EQ(100, std::max_element(mags.begin(), mags.end()) - mags.begin());
+    // Hamming window coherent gain is 0.54, so a sine of amplitude A peaks at A * N / 2 * 0.54
+    EXPECT_NEAR(10000.0f * n / 2 * 0.54f, mags[100], 10000.0f * n / 2 * 0.01f);
+}
+
+TEST(FFTTestSuite, FixedPointMatchesFloat) {
+    constexpr std::size_t n = 2048;
+    RealFFT fft(n);
+    RealFFTQ15 fftQ15(n);
+
+    // loud and quiet versions of the same signal, to exercise the block scaling
+    for (float gain : {1.0f, 0.01f}) {
+        auto signal = testSignal(n);
+        std::vector<float> input(n);
+        std::vector<int16_t> inputQ15(n);
+        for (std::size_t i = 0; i < n; i++) {
+            inputQ15[i] = static_cast<int16_t>(std::lround(signal[i] * gain));
+            input[i] = inputQ15[i];
+        }
+
+        std::vector<float> mags(n / 2);
+        std::vector<uint32_t> magsQ15(n / 2);
+        fft.magnitudes(input, mags);
+        fftQ15.magnitudes(inputQ15, magsQ15);
+
+        float peak = *std::max_element(mags.begin(), mags.end());
+        for (std::size_t k = 0; k < n / 2; k++) { EXPECT_NEAR(mags[k], magsQ15[k], peak * 2e-3) << gain << " " << k; }
+    }
+}
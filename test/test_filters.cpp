@@ -0,0 +1,64 @@
+/* Project Scope */
+#include "display/effects/clockfaces.h"
+#include "display/effects/filters.h"
+#include "modes/clockface.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <memory>
+#include <vector>
+
+namespace {
+
+ClockFaceTimeStruct thirtySecondsIn() {
+    ClockFaceTimeStruct t{};
+    t.hour24 = 13;
+    t.hour12 = 1;
+    t.minute = 30;
+    t.second = 30;
+    return t;
+}
+
+} // namespace
+
+TEST(FiltersTestSuite, RainbowWaveRedrawsEachHueStep) {
+    EXPECT_EQ(RainbowWave(1.0f, 30).getUpdateInterval(), 1000u);
+    EXPECT_EQ(RainbowWave(-4.0f, 30).getUpdateInterval(), 250u);
+    EXPECT_EQ(RainbowWave(0.0f, 30).getUpdateInterval(), frameRate::idle);
+    // steps shorter than two frames would be rounded up to two, so these run at the full rate
+    EXPECT_EQ(RainbowWave(50.0f, 30).getUpdateInterval(), frameRate::continuous);
+    EXPECT_EQ(RainbowWave(1000.0f / frameRate::fullRatePeriod, 30).getUpdateInterval(), frameRate::continuous);
+}
+
+TEST(FiltersTestSuite, StaticFiltersNeverNeedRedrawing) {
+    EXPECT_EQ(SolidColour(flm::CRGB::White).getUpdateInterval(), frameRate::idle);
+    EXPECT_EQ(HSVTestPattern().getUpdateInterval(), frameRate::idle);
+}
+
+TEST(FiltersTestSuite, ClockFaceModeRateFollowsFaceAndFilter) {
+    Button2 mode, select, left, right;
+    const ButtonReferences buttons{mode, select, left, right};
+    const canvas::Canvas size(17, 5);
+    const FrameContext frame{};
+
+    auto makeMode = [&](std::unique_ptr<FilterMethod> filter) {
+        std::vector<std::unique_ptr<DisplayEffect>> faces;
+        faces.push_back(std::make_unique<ClockFace_Simple>(thirtySecondsIn));
+        std::vector<std::unique_ptr<FilterMethod>> filters;
+        filters.push_back(std::move(filter));
+        return std::make_unique<Mode_ClockFace>(size, buttons, std::move(faces), std::move(filters));
+    };
+
+    // a static face through a static filter sleeps until the minute changes
+    EXPECT_EQ(
+        makeMode(std::make_unique<SolidColour>(flm::CRGB::White, false))->getUpdateInterval(frame),
+        frameRate::untilNextMinute(30));
+    // a slow wave sets the rate, and the default wave animates at the full rate
+    EXPECT_EQ(makeMode(std::make_unique<RainbowWave>(2.0f, 30))->getUpdateInterval(frame), 500u);
+    EXPECT_EQ(
+        makeMode(std::make_unique<RainbowWave>(50.0f, 30, RainbowWave::Direction::vertical, false))
+            ->getUpdateInterval(frame),
+        frameRate::continuous);
+}
@@ -0,0 +1,99 @@
+/* Project Scope */
+#include "frameScheduler.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* Arduino Core */
+#include <Arduino.h>
+
+/* C++ Standard Library */
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+TEST(FrameSchedulerTestSuite, DeadlinesFollowAFixedGrid) {
+    FrameScheduler scheduler(10000);
+    EXPECT_EQ(scheduler.schedule(5000), 5000u);
+    // frames finishing early wait for the grid, whatever time they finished at
+    EXPECT_EQ(scheduler.schedule(7000), 15000u);
+    EXPECT_EQ(scheduler.schedule(24999), 25000u);
+    EXPECT_EQ(scheduler.schedule(25000), 35000u);
+    EXPECT_EQ(scheduler.getOverruns(), 0u);
+    EXPECT_EQ(scheduler.getSkippedFrames(), 0u);
+}
+
+TEST(FrameSchedulerTestSuite, SkipDropsMissedDeadlines) {
+    FrameScheduler scheduler(10000, FrameScheduler::OverrunPolicy::skip);
+    scheduler.schedule(0);
+    // deadline 10000 was met late, and those at 20000 and 30000 passed entirely
+    EXPECT_EQ(scheduler.schedule(34000), 34000u);
+    EXPECT_EQ(scheduler.getOverruns(), 1u);
+    EXPECT_EQ(scheduler.getSkippedFrames(), 2u);
+    // back on the grid
+    EXPECT_EQ(scheduler.schedule(35000), 40000u);
+}
+
+TEST(FrameSchedulerTestSuite, CatchUpRunsLateFramesBackToBack) {
+    FrameScheduler scheduler(10000, FrameScheduler::OverrunPolicy::catchUp, 2);
+    scheduler.schedule(0);
+    // five deadlines missed: the frame due at 10000 runs now, two more catch up, and two are dropped
+    EXPECT_EQ(scheduler.schedule(55000), 55000u);
+    EXPECT_EQ(scheduler.getSkippedFrames(), 2u);
+    EXPECT_EQ(scheduler.schedule(55100), 55100u);
+    EXPECT_EQ(scheduler.schedule(55200), 55200u);
+    EXPECT_EQ(scheduler.getOverruns(), 3u);
+    EXPECT_EQ(scheduler.schedule(55300), 60000u);
+    EXPECT_EQ(scheduler.getSkippedFrames(), 2u);
+}
+
+TEST(FrameSchedulerTestSuite, HandlesTheClockWrapping) {
+    FrameScheduler scheduler(10000);
+    const uint32_t start = UINT32_MAX - 15000;
+    scheduler.schedule(start);
+    EXPECT_EQ(scheduler.schedule(start + 1000), start + 10000);
+    EXPECT_EQ(scheduler.schedule(start + 12000), uint32_t(start + 20000));
+    EXPECT_EQ(scheduler.getOverruns(), 0u);
+}
+
+TEST(FrameSchedulerTestSuite, SleepsUntilTheNextFrame) {
+    FrameScheduler scheduler(5000);
+    scheduler.waitForNextFrame();
+    const uint32_t first = micros();
+    for (int i = 0; i < 4; i++) { scheduler.waitForNextFrame(); }
+    const uint32_t elapsed = micros() - first;
+    EXPECT_GE(elapsed, 19000u);
+    EXPECT_LT(elapsed, 200000u);
+}
+
+TEST(FrameSchedulerTestSuite, IdleFramesMoveToTheGridAfterTheIdleTime) {
+    FrameScheduler scheduler(10000);
+    scheduler.schedule(0);
+    // nothing changes for 35 ms after the frame at 0, so the next frame is the first deadline after that
+    EXPECT_EQ(scheduler.schedule(2000, 35000), 40000u);
+    EXPECT_EQ(scheduler.schedule(41000, 1000000), 1040000u);
+    // an idle time shorter than the period changes nothing
+    EXPECT_EQ(scheduler.schedule(1041000, 5000), 1050000u);
+    EXPECT_EQ(scheduler.schedule(1051000), 1060000u);
+    EXPECT_EQ(scheduler.getOverruns(), 0u);
+    EXPECT_EQ(scheduler.getSkippedFrames(), 0u);
+}
+
+TEST(FrameSchedulerTestSuite, WakeEndsTheSleepEarly) {
+    FrameScheduler scheduler(10000);
+    scheduler.waitForNextFrame();
+    std::thread waker([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        scheduler.wake(true);
+    });
+    const uint32_t start = micros();
+    scheduler.waitForNextFrame(10000000);
+    const uint32_t slept = micros() - start;
+    waker.join();
+    EXPECT_GE(slept, 15000u);
+    EXPECT_LT(slept, 1000000u);
+
+    // held at the full rate after the wake, whatever idle time is asked for
+    const uint32_t now = micros();
+    EXPECT_LT(scheduler.schedule(now, 10000000) - now, 20000u);
+}
@@ -0,0 +1,71 @@
+/* Project Scope */
+#include "instrumentation.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+TEST(InstrumentationTestSuite, HistogramBucketsAreOrderedAndTight) {
+    EXPECT_EQ(LogHistogram::bucketOf(0), 0u);
+    EXPECT_EQ(LogHistogram::bucketOf(7), 7u);
+    EXPECT_EQ(LogHistogram::bucketOf(UINT32_MAX), LogHistogram::bucketCount - 1);
+
+    std::size_t previous = 0;
+    for (uint64_t v = 1; v <= UINT32_MAX; v = v * 9 / 8 + 1) {
+        const auto value = static_cast<uint32_t>(v);
+        const std::size_t bucket = LogHistogram::bucketOf(value);
+        EXPECT_GE(bucket, previous);
+        previous = bucket;
+        // every value is within 1/16 of its bucket's representative value
+        const double representative = LogHistogram::bucketValue(bucket);
+        EXPECT_NEAR(representative, value, value / 16.0 + 0.5) << value;
+    }
+}
+
+TEST(InstrumentationTestSuite, PercentilesMatchTheSortedValues) {
+    InstrumentationTrace trace("Test", InstrumentationTrace::Detail::percentiles);
+    ASSERT_TRUE(trace.hasPercentiles());
+
+    std::minstd_rand rand(3);
+    std::exponential_distribution<double> dist(1.0 / 2000);
+    std::vector<uint32_t> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(static_cast<uint32_t>(dist(rand)));
+        trace.update(values.back());
+    }
+    // a rare stall, only visible in the tail
+    for (int i = 0; i < 20; i++) {
+        values.push_back(50000);
+        trace.update(50000);
+    }
+    std::sort(values.begin(), values.end());
+
+    for (float fraction : {0.5f, 0.9f, 0.99f, 0.999f}) {
+        const uint32_t expected = values[static_cast<std::size_t>(fraction * values.size()) - 1];
+        EXPECT_NEAR(trace.getPercentile(fraction), expected, expected / 16.0 + 1) << fraction;
+    }
+    EXPECT_EQ(trace.getPercentile(1.0f), 50000u);
+    EXPECT_EQ(trace.getMax(), 50000u);
+
+    trace.reset();
+    EXPECT_EQ(trace.getPercentile(0.5f), 0u);
+    EXPECT_EQ(trace.getAvg(), 0u);
+}
+
+TEST(InstrumentationTestSuite, SummaryOnlyByDefault) {
+    InstrumentationTrace trace("Test");
+    EXPECT_FALSE(trace.hasPercentiles());
+    trace.update(10);
+    trace.update(20);
+    trace.update(31);
+    EXPECT_EQ(trace.getHits(), 3u);
+    EXPECT_EQ(trace.getMin(), 10u);
+    EXPECT_EQ(trace.getMax(), 31u);
+    EXPECT_EQ(trace.getAvg(), 20u);
+    EXPECT_EQ(trace.getPercentile(0.5f), 0u);
+}
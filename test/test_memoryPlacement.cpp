@@ -0,0 +1,97 @@
+/* Project Scope */
+#include "memoryPlacement.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+const memory::PlacementRecord* findRecord(const std::vector<memory::PlacementRecord>& report, const char* name) {
+    for (const auto& r : report) {
+        if (std::strcmp(r.name, name) == 0) { return &r; }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(MemoryPlacementTestSuite, TracksLiveBuffersByName) {
+    void* a = memory::allocate(100, memory::Placement::hot, "Test hot buffer");
+    void* b = memory::allocate(28, memory::Placement::hot, "Test hot buffer");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % alignof(std::max_align_t), 0u);
+    std::memset(a, 0xAB, 100);
+
+    auto r = findRecord(memory::getPlacementReport(), "Test hot buffer");
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->placement, memory::Placement::hot);
+    EXPECT_EQ(r->region, memory::Region::internal);
+    EXPECT_EQ(r->liveBytes, 128u);
+    EXPECT_EQ(r->liveCount, 2u);
+    EXPECT_EQ(r->fallbacks, 0u);
+
+    memory::release(a);
+    memory::release(b);
+    memory::release(nullptr);
+    r = findRecord(memory::getPlacementReport(), "Test hot buffer");
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->liveBytes, 0u);
+    EXPECT_EQ(r->liveCount, 0u);
+}
+
+TEST(MemoryPlacementTestSuite, BulkFallsBackToInternalWithoutPSRAM) {
+    void* p = memory::allocate(64, memory::Placement::bulk, "Test bulk buffer");
+    ASSERT_NE(p, nullptr);
+
+    auto r = findRecord(memory::getPlacementReport(), "Test bulk buffer");
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->placement, memory::Placement::bulk);
+    // the desktop build has no PSRAM, so the buffer lands in internal RAM and is counted as a fallback
+    EXPECT_EQ(r->region, memory::Region::internal);
+    EXPECT_EQ(r->fallbacks, 1u);
+    memory::release(p);
+}
+
+TEST(MemoryPlacementTestSuite, PlacedVectorUsesItsPlacement) {
+    {
+        memory::PlacedVector<uint32_t> v{{memory::Placement::bulk, "Test vector"}};
+        v.assign(10, 7);
+        v.push_back(8);
+        memory::PlacedVector<uint32_t> copy = v;
+        EXPECT_EQ(copy.size(), 11u);
+        EXPECT_EQ(copy.back(), 8u);
+        EXPECT_EQ(copy.get_allocator().getPlacement(), memory::Placement::bulk);
+
+        auto r = findRecord(memory::getPlacementReport(), "Test vector");
+        ASSERT_NE(r, nullptr);
+        EXPECT_EQ(r->liveCount, 2u);
+        EXPECT_GE(r->liveBytes, 2 * 11 * sizeof(uint32_t));
+    }
+    auto r = findRecord(memory::getPlacementReport(), "Test vector");
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->liveCount, 0u);
+    EXPECT_EQ(r->liveBytes, 0u);
+}
+
+TEST(MemoryPlacementTestSuite, AllocatorsCompareByPlacementAndName) {
+    using Allocator = memory::PlacementAllocator<uint32_t>;
+    const Allocator a{memory::Placement::bulk, "Test allocator A"};
+    EXPECT_EQ(a, (Allocator{memory::Placement::bulk, "Test allocator A"}));
+    EXPECT_NE(a, (Allocator{memory::Placement::hot, "Test allocator A"}));
+    EXPECT_NE(a, (Allocator{memory::Placement::bulk, "Test allocator B"}));
+
+    // a move takes the allocator along, so the storage stays under the record it was allocated to
+    memory::PlacedVector<uint32_t> from(16, 1, a);
+    memory::PlacedVector<uint32_t> to{{memory::Placement::hot, "Test allocator B"}};
+    to = std::move(from);
+    EXPECT_EQ(to.get_allocator(), a);
+    auto r = findRecord(memory::getPlacementReport(), "Test allocator A");
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->liveCount, 1u);
+}
@@ -0,0 +1,43 @@
+/* Project Scope */
+#include "EMA.h"
+#include "runningStatistics.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+
+TEST(RunningStatisticsTestSuite, MatchesRecomputingTheWindow) {
+    constexpr std::size_t window = 7;
+    utility::RunningSum<float, window> sum;
+    utility::RunningMinMax<float, window> minMax;
+    std::deque<float> recent;
+
+    EXPECT_EQ(sum.getMean(), 0);
+    std::srand(1);
+    for (int i = 0; i < 1000; i++) {
+        // include runs of rising, falling and repeated values
+        float value = (i % 50 < 10) ? float(i % 50) : (i % 50 < 20) ? float(50 - i % 50) : float(std::rand() % 21 - 10);
+        sum.push(value);
+        minMax.push(value);
+        recent.push_back(value);
+        if (recent.size() > window) { recent.pop_front(); }
+
+        float expectedSum = 0;
+        for (float v : recent) { expectedSum += v; }
+        ASSERT_EQ(sum.size(), recent.size());
+        ASSERT_NEAR(sum.getMean(), expectedSum / recent.size(), 1e-4) << i;
+        ASSERT_EQ(minMax.getMin(), *std::min_element(recent.begin(), recent.end())) << i;
+        ASSERT_EQ(minMax.getMax(), *std::max_element(recent.begin(), recent.end())) << i;
+    }
+}
+
+TEST(RunningStatisticsTestSuite, EMAStartsFromFirstValue) {
+    utility::EMA ema(0.5f);
+    EXPECT_EQ(ema.update(-40), -40);
+    EXPECT_EQ(ema.update(-20), -30);
+    EXPECT_EQ(ema.update(-20), -25);
+}
@@ -0,0 +1,67 @@
+/* Project Scope */
+#include "seqlockHistory.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+struct Sample {
+    std::array<uint32_t, 20> values;
+};
+
+Sample makeSample(uint32_t v) {
+    Sample s;
+    s.values.fill(v);
+    return s;
+}
+
+} // namespace
+
+TEST(SeqlockHistoryTestSuite, ReadsByAge) {
+    SeqlockHistory<Sample, 4> history;
+    Sample out;
+    EXPECT_TRUE(history.empty());
+    EXPECT_FALSE(history.read(0, out));
+
+    for (uint32_t i = 1; i <= 6; i++) { history.publish(makeSample(i)); }
+    EXPECT_EQ(4u, history.size());
+    EXPECT_EQ(6u, history.getPublishedCount());
+
+    ASSERT_TRUE(history.read(0, out));
+    EXPECT_EQ(6u, out.values[0]);
+    ASSERT_TRUE(history.read(3, out));
+    EXPECT_EQ(3u, out.values[0]);
+    EXPECT_FALSE(history.read(4, out));
+}
+
+TEST(SeqlockHistoryTestSuite, ConcurrentReadsAreNeverTorn) {
+    SeqlockHistory<Sample, 4> history;
+    std::atomic<bool> done{false};
+    constexpr uint32_t total = 20000;
+
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= total; i++) {
+            history.publish(makeSample(i));
+            if (i % 64 == 0) { std::this_thread::yield(); }
+        }
+        done = true;
+    });
+
+    uint32_t lastSeen = 0;
+    while (!done) {
+        Sample out;
+        if (!history.read(0, out)) { continue; }
+        for (auto v : out.values) { ASSERT_EQ(out.values[0], v); }
+        // the latest value never goes backwards
+        ASSERT_GE(out.values[0], lastSeen);
+        lastSeen = out.values[0];
+    }
+    writer.join();
+}
@@ -0,0 +1,89 @@
+/* Project Scope */
+#include "spscRing.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST(SpscRingTestSuite, WrapsAround) {
+    std::array<int16_t, 8> storage{};
+    SpscRing<int16_t> ring(storage.data(), storage.size());
+
+    std::array<int16_t, 6> in{1, 2, 3, 4, 5, 6};
+    std::array<int16_t, 6> out{};
+    EXPECT_EQ(6u, ring.write(in));
+    EXPECT_EQ(4u, ring.read(etl::span<int16_t>(out.data(), 4)));
+
+    // the second write straddles the end of the storage
+    EXPECT_EQ(6u, ring.write(in));
+    EXPECT_EQ(8u, ring.size());
+    EXPECT_EQ(0u, ring.free());
+    EXPECT_EQ(0u, ring.write(in));
+
+    EXPECT_EQ(2u, ring.read(etl::span<int16_t>(out.data(), 2)));
+    EXPECT_EQ(5, out[0]);
+    EXPECT_EQ(6, out[1]);
+    EXPECT_EQ(6u, ring.read(out));
+    EXPECT_EQ(in, out);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTestSuite, ConcurrentHandoffPreservesOrder) {
+    std::array<uint32_t, 64> storage{};
+    SpscRing<uint32_t> ring(storage.data(), storage.size());
+    constexpr uint32_t total = 20000;
+
+    std::thread producer([&]() {
+        std::array<uint32_t, 7> chunk;
+        uint32_t next = 0;
+        while (next < total) {
+            std::size_t n = std::min<std::size_t>(chunk.size(), total - next);
+            for (std::size_t i = 0; i < n; i++) { chunk[i] = next + static_cast<uint32_t>(i); }
+            std::size_t written = ring.write(etl::span<const uint32_t>(chunk.data(), n));
+            if (written == 0) { std::this_thread::yield(); }
+            next += static_cast<uint32_t>(written);
+        }
+    });
+
+    std::vector<uint32_t> received;
+    received.reserve(total);
+    std::array<uint32_t, 5> chunk;
+    while (received.size() < total) {
+        std::size_t n = ring.read(chunk);
+        if (n == 0) { std::this_thread::yield(); }
+        received.insert(received.end(), chunk.begin(), chunk.begin() + n);
+    }
+    producer.join();
+
+    for (uint32_t i = 0; i < total; i++) { ASSERT_EQ(i, received[i]); }
+}
+
+TEST(SpscRingTestSuite, PeekAndSkip) {
+    std::array<int16_t, 8> storage{};
+    SpscRing<int16_t> ring(storage.data(), storage.size());
+
+    std::array<int16_t, 6> in{1, 2, 3, 4, 5, 6};
+    ring.write(in);
+    ring.skip(5);
+    ring.write(in);
+
+    // the oldest 4 values wrap around the end of the storage
+    auto view = ring.peek(4);
+    ASSERT_EQ(3u, view.first.size());
+    ASSERT_EQ(1u, view.second.size());
+    EXPECT_EQ(6, view.first[0]);
+    EXPECT_EQ(1, view.first[1]);
+    EXPECT_EQ(2, view.first[2]);
+    EXPECT_EQ(3, view.second[0]);
+
+    // peeking does not consume
+    EXPECT_EQ(7u, ring.size());
+    ring.skip(2);
+    EXPECT_EQ(5u, ring.size());
+    EXPECT_EQ(2, ring.peek(1).first[0]);
+}
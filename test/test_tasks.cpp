@@ -0,0 +1,50 @@
+/* Project Scope */
+#include "tasks.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <chrono>
+#include <thread>
+
+TEST(TasksTestSuite, AddReturnsTheSameStatsForTheSameTask) {
+    constexpr tasks::TaskConfig worker{"TestWorker", 4096, 3, tasks::anyCore};
+    tasks::TaskMonitor monitor;
+    tasks::TaskStats& a = monitor.add(worker);
+    tasks::TaskStats& b = monitor.add(worker);
+    EXPECT_EQ(&a, &b);
+    EXPECT_EQ(a.getConfig().stackBytes, 4096u);
+    EXPECT_NE(&monitor.add(tasks::config::render), &a);
+}
+
+TEST(TasksTestSuite, CountsMissedNotifications) {
+    tasks::TaskMonitor monitor;
+    tasks::TaskStats& stats = monitor.add(tasks::config::audio);
+    stats.woke(1);
+    stats.woke(3);
+    stats.woke(2);
+    EXPECT_EQ(stats.takeMissed(), 3u);
+    EXPECT_EQ(stats.takeMissed(), 0u);
+}
+
+TEST(TasksTestSuite, AccumulatesBusyTime) {
+    tasks::TaskMonitor monitor;
+    tasks::TaskStats& stats = monitor.add(tasks::config::render);
+    stats.workStop(); // without a start, ignored
+    EXPECT_EQ(stats.takeBusyUs(), 0u);
+
+    for (int i = 0; i < 2; i++) {
+        stats.workStart();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        stats.workStop();
+    }
+    const uint32_t busy = stats.takeBusyUs();
+    EXPECT_GE(busy, 10000u);
+    EXPECT_LT(busy, 1000000u);
+    EXPECT_EQ(stats.takeBusyUs(), 0u);
+
+    // no FreeRTOS on desktop, so no stack figures or spawned tasks
+    EXPECT_EQ(stats.getStackFreeMin(), -1);
+    EXPECT_EQ(tasks::spawn(tasks::config::audio, [](void*) {}, nullptr), nullptr);
+}
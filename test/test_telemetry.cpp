@@ -0,0 +1,239 @@
+/* Project Scope */
+#include "telemetry.h"
+#include "timeline.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace telemetry;
+
+namespace {
+
+Sample makeSample(uint32_t sequence) {
+    Sample s{};
+    s.sequence = sequence;
+    s.timeMs = 123456789;
+    s.overruns = 3;
+    s.skippedFrames = 7;
+    s.dropped = 1;
+    s.freeHeap = 150000;
+    s.minFreeHeap = 120000;
+    s.freePsram = 4000000;
+    s.traceCount = 2;
+    s.traces[0] = {60, 900, 25000, 16000, 24000};
+    s.traces[1] = {6, 10, 5000, 300, 0};
+    return s;
+}
+
+std::vector<uint8_t> encodeToBytes(const Sample& sample) {
+    std::array<uint8_t, maxFrameSize> buffer{};
+    const std::size_t size = encode(sample, buffer);
+    return {buffer.begin(), buffer.begin() + size};
+}
+
+struct Capture {
+    Capture() {
+        decoder.onSample = [this](const Sample& s) { samples.push_back(s); };
+    }
+    Decoder decoder;
+    std::vector<Sample> samples;
+};
+
+} // namespace
+
+TEST(TelemetryTestSuite, Crc16MatchesCheckValue) {
+    const std::string check = "123456789";
+    EXPECT_EQ(crc16({reinterpret_cast<const uint8_t*>(check.data()), check.size()}), 0x29B1);
+}
+
+TEST(TelemetryTestSuite, FrameLayout) {
+    const auto bytes = encodeToBytes(makeSample(5));
+    const std::size_t payloadSize = 8 * 4 + 1 + 2 * 5 * 4;
+    ASSERT_EQ(bytes.size(), headerSize + payloadSize + crcSize);
+    EXPECT_EQ(bytes[0], syncBytes[0]);
+    EXPECT_EQ(bytes[1], syncBytes[1]);
+    EXPECT_EQ(bytes[2], protocolVersion);
+    EXPECT_EQ(bytes[3], static_cast<uint8_t>(FrameType::sample));
+    EXPECT_EQ(bytes[4] | (bytes[5] << 8), int(payloadSize));
+    // sequence, little-endian
+    EXPECT_EQ(bytes[6], 5);
+    EXPECT_EQ(bytes[7], 0);
+}
+
+TEST(TelemetryTestSuite, EncodeFailsWhenTooSmall) {
+    std::array<uint8_t, 20> small{};
+    EXPECT_EQ(encode(makeSample(0), small), 0u);
+}
+
+TEST(TelemetryTestSuite, RoundTripsThroughDecoder) {
+    Capture capture;
+    std::vector<std::string> names{"Overall Loop", "Mode Run"};
+    std::array<uint8_t, maxFrameSize> buffer{};
+    const std::size_t namesSize = encode(names, buffer);
+    capture.decoder.feed({buffer.data(), namesSize});
+    EXPECT_EQ(capture.decoder.getTraceNames(), names);
+
+    const Sample sent = makeSample(42);
+    const auto bytes = encodeToBytes(sent);
+    // a byte at a time, as from a serial port
+    for (uint8_t b : bytes) { capture.decoder.feed({&b, 1}); }
+
+    ASSERT_EQ(capture.samples.size(), 1u);
+    const Sample& got = capture.samples[0];
+    EXPECT_EQ(got.sequence, 42u);
+    EXPECT_EQ(got.timeMs, sent.timeMs);
+    EXPECT_EQ(got.overruns, sent.overruns);
+    EXPECT_EQ(got.skippedFrames, sent.skippedFrames);
+    EXPECT_EQ(got.dropped, sent.dropped);
+    EXPECT_EQ(got.freeHeap, sent.freeHeap);
+    EXPECT_EQ(got.minFreeHeap, sent.minFreeHeap);
+    EXPECT_EQ(got.freePsram, sent.freePsram);
+    ASSERT_EQ(got.traceCount, 2);
+    EXPECT_EQ(got.traces[0].hits, 60u);
+    EXPECT_EQ(got.traces[0].maxUs, 25000u);
+    EXPECT_EQ(got.traces[0].p99Us, 24000u);
+    EXPECT_EQ(got.traces[1].avgUs, 300u);
+    EXPECT_EQ(capture.decoder.getFrames(), 2u);
+}
+
+TEST(TelemetryTestSuite, ResynchronisesAfterNoiseAndCorruption) {
+    Capture capture;
+    std::vector<uint8_t> stream{'b', 'o', 'o', 't', '\n', syncBytes[0], 0x00, syncBytes[0]};
+    auto corrupt = encodeToBytes(makeSample(2));
+    corrupt[10] ^= 0xFF;
+    for (const auto& frame : {encodeToBytes(makeSample(1)), corrupt, encodeToBytes(makeSample(3))}) {
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+
+    capture.decoder.feed(stream);
+    ASSERT_EQ(capture.samples.size(), 2u);
+    EXPECT_EQ(capture.samples[0].sequence, 1u);
+    EXPECT_EQ(capture.samples[1].sequence, 3u);
+    EXPECT_GE(capture.decoder.getCrcErrors(), 1u);
+    EXPECT_GT(capture.decoder.getSkippedBytes(), 0u);
+}
+
+TEST(TelemetryTestSuite, SkipsUnknownVersions) {
+    Capture capture;
+    auto future = encodeToBytes(makeSample(1));
+    future[2] = protocolVersion + 1;
+    const uint16_t crc = crc16({future.data() + 2, future.size() - 2 - crcSize});
+    future[future.size() - 2] = static_cast<uint8_t>(crc);
+    future[future.size() - 1] = static_cast<uint8_t>(crc >> 8);
+    const auto current = encodeToBytes(makeSample(2));
+    future.insert(future.end(), current.begin(), current.end());
+
+    capture.decoder.feed(future);
+    ASSERT_EQ(capture.samples.size(), 1u);
+    EXPECT_EQ(capture.samples[0].sequence, 2u);
+    EXPECT_EQ(capture.decoder.getUnsupportedFrames(), 1u);
+}
+
+TEST(TelemetryTestSuite, StreamDropsWholeFramesWhenFull) {
+    TelemetryStream stream;
+    const std::size_t frameSize = encodeToBytes(makeSample(0)).size();
+    const std::size_t fit = TelemetryStream::ringSize / frameSize;
+    for (std::size_t i = 0; i < fit; i++) { EXPECT_TRUE(stream.publish(makeSample(static_cast<uint32_t>(i)))); }
+    EXPECT_FALSE(stream.publish(makeSample(99)));
+    EXPECT_EQ(stream.getDropped(), 1u);
+
+    Capture capture;
+    const std::size_t drained = stream.drain([&](etl::span<const uint8_t> bytes) { capture.decoder.feed(bytes); });
+    EXPECT_EQ(drained, fit * frameSize);
+    ASSERT_EQ(capture.samples.size(), fit);
+    EXPECT_EQ(capture.samples.back().sequence, fit - 1);
+    EXPECT_EQ(capture.decoder.getCrcErrors(), 0u);
+
+    // room again once drained, and frames that wrap around the ring still decode
+    EXPECT_TRUE(stream.publish(makeSample(100)));
+    EXPECT_TRUE(stream.publish(makeSample(101)));
+    stream.drain([&](etl::span<const uint8_t> bytes) { capture.decoder.feed(bytes); });
+    EXPECT_EQ(capture.samples.back().sequence, 101u);
+    EXPECT_EQ(capture.samples.size(), fit + 2);
+}
+
+TEST(TelemetryTestSuite, RoundTripsReports) {
+    Capture capture;
+    std::vector<PlacementEntry> placement;
+    std::vector<TaskEntry> tasks;
+    std::vector<ScopedTraceEntry> scopedTraces;
+    capture.decoder.onPlacement = [&](const std::vector<PlacementEntry>& e) { placement = e; };
+    capture.decoder.onTasks = [&](const std::vector<TaskEntry>& e) { tasks = e; };
+    capture.decoder.onScopedTraces = [&](const std::vector<ScopedTraceEntry>& e) { scopedTraces = e; };
+
+    TelemetryStream stream;
+    EXPECT_TRUE(stream.publish(
+        std::vector<PlacementEntry>{{"FFT window", 1, 1, 8192, 1, 0}, {"GoL grid", 0, 0, 64, 2, 1}}));
+    EXPECT_TRUE(stream.publish(std::vector<TaskEntry>{{"AudioUpdate", 0, 10, 2048, 612, 25000, 5000000, 3}}));
+    EXPECT_TRUE(stream.publish(std::vector<TaskEntry>{{"Telemetry", -1, 1, 3072, -1, 0, 0, 0}}));
+    EXPECT_TRUE(stream.publish(std::vector<ScopedTraceEntry>{{"GoL Reset", 2, 100, 300, 200}}));
+    stream.drain([&](etl::span<const uint8_t> bytes) { capture.decoder.feed(bytes); });
+
+    ASSERT_EQ(placement.size(), 2u);
+    EXPECT_EQ(placement[0].name, "FFT window");
+    EXPECT_EQ(placement[0].liveBytes, 8192u);
+    EXPECT_EQ(placement[1].fallbacks, 1u);
+    ASSERT_EQ(tasks.size(), 1u);
+    EXPECT_EQ(tasks[0].name, "Telemetry");
+    EXPECT_EQ(tasks[0].core, -1);
+    EXPECT_EQ(tasks[0].stackFreeMin, -1);
+    ASSERT_EQ(scopedTraces.size(), 1u);
+    EXPECT_EQ(scopedTraces[0].name, "GoL Reset");
+    EXPECT_EQ(scopedTraces[0].avgUs, 200u);
+    EXPECT_EQ(capture.decoder.getFrames(), 4u);
+    EXPECT_EQ(capture.decoder.getUnsupportedFrames(), 0u);
+}
+
+TEST(TelemetryTestSuite, SamplesCarryEveryRegisteredTrace) {
+    Sample sample = makeSample(0);
+    sample.traceCount = 21;
+    for (std::size_t i = 0; i < sample.traceCount; i++) { sample.traces[i] = {uint32_t(i), 0, 0, 0, 0}; }
+    Capture capture;
+    const auto bytes = encodeToBytes(sample);
+    capture.decoder.feed(bytes);
+    ASSERT_EQ(capture.samples.size(), 1u);
+    ASSERT_EQ(capture.samples[0].traceCount, 21);
+    EXPECT_EQ(capture.samples[0].traces[20].hits, 20u);
+}
+
+TEST(TelemetryTestSuite, TimelineDumpRoundTripsInChunks) {
+    tracing::Timeline timeline;
+    timeline.start();
+    for (int i = 0; i < 20; i++) {
+        timeline.record("Telemetry Test Section", tracing::TimelineEvent::Phase::begin);
+        timeline.record("Telemetry Test Section", tracing::TimelineEvent::Phase::end);
+    }
+    std::string expected;
+    timeline.writeChromeTrace([&](const std::string& piece) { expected += piece; });
+    ASSERT_GT(expected.size(), TimelineChunk::maxSize);
+
+    TelemetryStream stream;
+    stream.publish(makeSample(1));
+    stream.publishTimeline(timeline);
+    stream.publish(makeSample(2));
+
+    Capture capture;
+    std::string json;
+    std::size_t chunks = 0;
+    bool complete = false;
+    capture.decoder.onTimelineChunk = [&](const TimelineChunk& chunk) {
+        EXPECT_EQ(chunk.first, chunks == 0);
+        EXPECT_FALSE(complete);
+        json += chunk.json;
+        complete = chunk.last;
+        chunks++;
+    };
+    stream.drain([&](etl::span<const uint8_t> bytes) { capture.decoder.feed(bytes); });
+
+    // the trace arrives whole, in several frames, between the samples around it
+    EXPECT_TRUE(complete);
+    EXPECT_GT(chunks, 1u);
+    EXPECT_EQ(json, expected);
+    EXPECT_EQ(capture.samples.size(), 2u);
+    EXPECT_EQ(capture.decoder.getCrcErrors(), 0u);
+}
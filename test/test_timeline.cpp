@@ -0,0 +1,137 @@
+/* Project Scope */
+#include "timeline.h"
+#include "tracing.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <string>
+#include <thread>
+#include <vector>
+
+using tracing::Timeline;
+using tracing::TimelineEvent;
+
+namespace {
+
+std::vector<TimelineEvent> eventsOf(const Timeline& timeline) {
+    std::vector<TimelineEvent> events;
+    timeline.forEachEvent([&](const TimelineEvent& e) { events.push_back(e); });
+    return events;
+}
+
+std::string chromeTraceOf(Timeline& timeline) {
+    std::string json;
+    timeline.writeChromeTrace([&](const std::string& piece) { json += piece; });
+    return json;
+}
+
+std::size_t countOf(const std::string& s, const std::string& what) {
+    std::size_t count = 0;
+    for (std::size_t i = s.find(what); i != std::string::npos; i = s.find(what, i + 1)) { count++; }
+    return count;
+}
+
+} // namespace
+
+TEST(TimelineTestSuite, RecordsNothingUntilStarted) {
+    Timeline timeline;
+    timeline.record("Ignored", TimelineEvent::Phase::begin);
+    EXPECT_TRUE(eventsOf(timeline).empty());
+
+    timeline.start();
+    timeline.record("Kept", TimelineEvent::Phase::begin);
+    timeline.stop();
+    timeline.record("Ignored", TimelineEvent::Phase::end);
+    EXPECT_EQ(eventsOf(timeline).size(), 1u);
+}
+
+TEST(TimelineTestSuite, KeepsBeginAndEndInOrder) {
+    Timeline timeline;
+    timeline.start();
+    timeline.record("Outer", TimelineEvent::Phase::begin);
+    timeline.record("Inner", TimelineEvent::Phase::begin);
+    timeline.record("Inner", TimelineEvent::Phase::end);
+    timeline.record("Outer", TimelineEvent::Phase::end);
+
+    const auto events = eventsOf(timeline);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_STREQ(events[0].name, "Outer");
+    EXPECT_EQ(events[0].phase, TimelineEvent::Phase::begin);
+    EXPECT_STREQ(events[1].name, "Inner");
+    EXPECT_EQ(events[2].phase, TimelineEvent::Phase::end);
+    EXPECT_STREQ(events[3].name, "Outer");
+    EXPECT_EQ(events[3].phase, TimelineEvent::Phase::end);
+    for (std::size_t i = 1; i < events.size(); i++) {
+        EXPECT_LE(events[i - 1].timeUs, events[i].timeUs);
+        EXPECT_EQ(events[i].thread, events[0].thread);
+    }
+}
+
+TEST(TimelineTestSuite, WrapsKeepingTheNewestEvents) {
+    Timeline timeline;
+    timeline.start();
+    const char* names[] = {"Old", "New"};
+    for (std::size_t i = 0; i < Timeline::capacity + 10; i++) {
+        timeline.record(names[i >= 10], TimelineEvent::Phase::begin);
+    }
+
+    const auto events = eventsOf(timeline);
+    ASSERT_EQ(events.size(), Timeline::capacity);
+    for (const auto& e : events) { EXPECT_STREQ(e.name, "New"); }
+}
+
+TEST(TimelineTestSuite, SeparatesThreads) {
+    Timeline timeline;
+    timeline.start();
+    timeline.record("Main", TimelineEvent::Phase::begin);
+    std::thread([&] {
+        timeline.record("Worker", TimelineEvent::Phase::begin);
+        timeline.record("Worker", TimelineEvent::Phase::end);
+    }).join();
+    timeline.record("Main", TimelineEvent::Phase::end);
+
+    const auto events = eventsOf(timeline);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_NE(events[0].thread, events[1].thread);
+    EXPECT_EQ(events[1].thread, events[2].thread);
+    EXPECT_EQ(events[0].thread, events[3].thread);
+}
+
+TEST(TimelineTestSuite, WritesChromeTraceJson) {
+    Timeline timeline;
+    timeline.start();
+    timeline.record("Audio \"FFT\"", TimelineEvent::Phase::begin);
+    timeline.record("Audio \"FFT\"", TimelineEvent::Phase::end);
+
+    const std::string json = chromeTraceOf(timeline);
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+    EXPECT_EQ(countOf(json, "\"ph\":\"B\""), 1u);
+    EXPECT_EQ(countOf(json, "\"ph\":\"E\""), 1u);
+    EXPECT_EQ(countOf(json, "\"ph\":\"M\""), 1u);
+    EXPECT_GE(countOf(json, "\"ts\":0,"), 1u);
+    EXPECT_NE(json.find("\"name\":\"Audio \\\"FFT\\\"\""), std::string::npos);
+    EXPECT_EQ(countOf(json, "{"), countOf(json, "}"));
+    // still recording afterwards
+    EXPECT_TRUE(timeline.recording());
+}
+
+TEST(TimelineTestSuite, TraceEdgesReachTheSingletonWhileRecording) {
+    auto countNamed = [](const char* name) {
+        std::size_t count = 0;
+        tracing::TimelineSingleton::get().forEachEvent([&](const TimelineEvent& e) {
+            if (std::string(e.name) == name) { count++; }
+        });
+        return count;
+    };
+
+    { PIXELCLOCK_TRACE_SCOPE("Test Timeline Off"); }
+    EXPECT_EQ(countNamed("Test Timeline Off"), 0u);
+
+    tracing::startTimeline();
+    { PIXELCLOCK_TRACE_SCOPE("Test Timeline On"); }
+    tracing::stopTimeline();
+    EXPECT_EQ(countNamed("Test Timeline On"), 2u);
+}
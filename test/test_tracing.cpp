@@ -0,0 +1,79 @@
+/* Project Scope */
+#include "tracing.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+/* C++ Standard Library */
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+const tracing::TracePoint* findTracePoint(const char* name) {
+    for (const tracing::TracePoint* p = tracing::firstTracePoint(); p; p = p->getNext()) {
+        if (std::strcmp(p->getName(), name) == 0) { return p; }
+    }
+    return nullptr;
+}
+
+void tracedSleep() {
+    PIXELCLOCK_TRACE_SCOPE("Test Traced Sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+}
+
+} // namespace
+
+TEST(TracingTestSuite, ScopedTraceRecordsEachPass) {
+    EXPECT_EQ(findTracePoint("Test Traced Sleep"), nullptr);
+    for (int i = 0; i < 3; i++) { tracedSleep(); }
+
+    const tracing::TracePoint* point = findTracePoint("Test Traced Sleep");
+    ASSERT_NE(point, nullptr);
+    EXPECT_EQ(point->getHits(), 3u);
+    EXPECT_LE(point->getMin(), point->getMax());
+
+    // converted to microseconds, each pass took at least the 2 ms sleep
+    const float minUs = point->getMin() / tracing::cyclesPerMicrosecond();
+    EXPECT_GE(minUs, 1900.0f);
+    EXPECT_LT(minUs, 500000.0f);
+}
+
+TEST(TracingTestSuite, EachCallSiteHasItsOwnPoint) {
+    for (int i = 0; i < 2; i++) {
+        PIXELCLOCK_TRACE_SCOPE("Test Site A");
+        PIXELCLOCK_TRACE_SCOPE("Test Site B");
+    }
+    PIXELCLOCK_TRACE_SCOPE("Test Site B");
+
+    std::size_t count = 0;
+    for (const tracing::TracePoint* p = tracing::firstTracePoint(); p; p = p->getNext()) {
+        if (std::strcmp(p->getName(), "Test Site B") == 0) {
+            count++;
+            EXPECT_TRUE(p->getHits() == 2 || p->getHits() == 0);
+        }
+    }
+    EXPECT_EQ(count, 2u);
+    EXPECT_EQ(findTracePoint("Test Site A")->getHits(), 2u);
+}
+
+TEST(TracingTestSuite, TracesOnOneLineHaveTheirOwnPoints) {
+    // clang-format off
+    { PIXELCLOCK_TRACE_SCOPE("Test Same Line A"); PIXELCLOCK_TRACE_SCOPE("Test Same Line B"); }
+    // clang-format on
+
+    ASSERT_NE(findTracePoint("Test Same Line A"), nullptr);
+    ASSERT_NE(findTracePoint("Test Same Line B"), nullptr);
+    EXPECT_EQ(findTracePoint("Test Same Line A")->getHits(), 1u);
+    EXPECT_EQ(findTracePoint("Test Same Line B")->getHits(), 1u);
+}
+
+TEST(TracingTestSuite, DesktopCountsDoNotWrapAt32Bits) {
+    static tracing::TracePoint point("Test Long Scope");
+    const tracing::Cycles fiveSecondsOfNanoseconds = 5000000000ull;
+    point.record(fiveSecondsOfNanoseconds);
+    EXPECT_EQ(point.getMax(), fiveSecondsOfNanoseconds);
+    EXPECT_EQ(point.getSum(), fiveSecondsOfNanoseconds);
+    point.reset();
+}
@@ -0,0 +1,110 @@
+/* Project Scope */
+#include "allocationTracking.h"
+#include "display/canvas.h"
+#include "display/transitions.h"
+
+/* Libraries */
+#include <gtest/gtest.h>
+
+using namespace canvas;
+
+TEST(TransitionsTestSuite, EasingTableEndpoints) {
+    EXPECT_EQ(0, transitions::easeInOutCubicTable.front());
+    EXPECT_EQ(255, transitions::easeInOutCubicTable.back());
+    EXPECT_EQ(0, transitions::easedProgress(-1.0f));
+    EXPECT_EQ(255, transitions::easedProgress(2.0f));
+}
+
+TEST(TransitionsTestSuite, KernelsShowEndpoints) {
+    Canvas from(17, 5);
+    Canvas to(17, 5);
+    Canvas out(17, 5);
+    from.fill(flm::CRGB::Red);
+    to.fill(flm::CRGB::Blue);
+
+    for (auto type : {
+             transitions::Type::slide,
+             transitions::Type::crossfade,
+             transitions::Type::wipe,
+             transitions::Type::dissolve,
+         }) {
+        transitions::compose(type, from, to, 0, 1, out);
+        EXPECT_TRUE(out == from) << transitions::typeName(type);
+        transitions::compose(type, from, to, 255, 1, out);
+        EXPECT_TRUE(out == to) << transitions::typeName(type);
+    }
+}
+
+TEST(TransitionsTestSuite, SlideDirection) {
+    Canvas from(4, 1);
+    Canvas to(4, 1);
+    Canvas out(4, 1);
+    from.fill(flm::CRGB::Red);
+    to.fill(flm::CRGB::Blue);
+
+    // halfway through a slide in from the right, the right half shows the incoming canvas
+    transitions::slide(from, to, 128, 1, out);
+    EXPECT_EQ(out.getXY(0, 0), flm::CRGB::Red);
+    EXPECT_EQ(out.getXY(3, 0), flm::CRGB::Blue);
+
+    transitions::slide(from, to, 128, -1, out);
+    EXPECT_EQ(out.getXY(0, 0), flm::CRGB::Blue);
+    EXPECT_EQ(out.getXY(3, 0), flm::CRGB::Red);
+}
+
+TEST(TransitionsTestSuite, SmallerInputPaddedWithBlack) {
+    Canvas from;
+    Canvas to(4, 1);
+    Canvas out(4, 1);
+    to.fill(flm::CRGB::Blue);
+
+    transitions::crossfade(from, to, 0, out);
+    EXPECT_FALSE(out.containsColour(flm::CRGB::Blue));
+}
+
+TEST(TransitionsTestSuite, TransitionHoldsSnapshot) {
+    Canvas outgoing(4, 1);
+    Canvas incoming(4, 1);
+    outgoing.fill(flm::CRGB::Red);
+    incoming.fill(flm::CRGB::Blue);
+
+    transitions::Transition transition(outgoing);
+    transition.start(outgoing, transitions::Type::wipe, 100);
+    EXPECT_TRUE(transition.active());
+
+    // changes to the outgoing source after the start are not seen by the transition
+    outgoing.fill(flm::CRGB::Green);
+
+    FrameClock clock;
+    clock.tick(0);
+    const Canvas& mid = transition.apply(incoming, clock.tick(50));
+    EXPECT_TRUE(mid.containsColour(flm::CRGB::Red));
+    EXPECT_TRUE(mid.containsColour(flm::CRGB::Blue));
+    EXPECT_FALSE(mid.containsColour(flm::CRGB::Green));
+
+    const Canvas& end = transition.apply(incoming, clock.tick(100));
+    EXPECT_FALSE(transition.active());
+    EXPECT_TRUE(end == incoming);
+}
+
+TEST(TransitionsTestSuite, TransitionDoesNotAllocate) {
+    Canvas outgoing(17, 5);
+    Canvas incoming(17, 5);
+    Canvas out(17, 5);
+    transitions::Transition transition(outgoing);
+    FrameClock clock;
+    clock.tick(0);
+
+    const auto before = alloc::getTotalCounters().allocations;
+    for (auto type : {
+             transitions::Type::slide,
+             transitions::Type::crossfade,
+             transitions::Type::wipe,
+             transitions::Type::dissolve,
+         }) {
+        transitions::compose(type, outgoing, incoming, 100, 1, out);
+    }
+    transition.start(outgoing, transitions::Type::crossfade, 100);
+    transition.apply(incoming, clock.tick(50));
+    EXPECT_EQ(before, alloc::getTotalCounters().allocations);
+}
@@ -0,0 +1,148 @@
+/* Project Scope */
+#include "FMTWrapper.h"
+#include "memoryPlacement.h"
+#include "telemetry.h"
+
+/* C++ Standard Library */
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Decodes the binary telemetry stream (see telemetry.h) into CSV, one row per sample.
+ *
+ *     PixelClock_TelemetryDecoder capture.bin > telemetry.csv
+ *     PixelClock_TelemetryDecoder /dev/ttyUSB0 > telemetry.csv
+ *
+ * reads a capture or a serial port (set it up first, e.g. 'stty -F /dev/ttyUSB0 921600 raw'), or standard input if
+ * no path is given. The header is written again whenever the trace names change. The memory placement, task and scoped
+ * trace reports, sent every few seconds, are printed as tables on standard error. A timeline dumped with TRACE DUMP is
+ * written to timeline.json, or the path given with '--timeline <path>', ready for chrome://tracing or Perfetto.
+ */
+int main(int argc, char** argv) {
+    std::string inputPath;
+    std::string timelinePath = "timeline.json";
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--timeline" && i + 1 < argc) {
+            timelinePath = argv[++i];
+        } else {
+            inputPath = arg;
+        }
+    }
+
+    std::ifstream file;
+    if (!inputPath.empty()) {
+        file.open(inputPath, std::ios::binary);
+        if (!file) {
+            std::cerr << fmt::format("Could not open {}\n", inputPath);
+            return 1;
+        }
+    }
+    std::istream& in = inputPath.empty() ? std::cin : file;
+
+    telemetry::Decoder decoder;
+    bool headerDue = true;
+    decoder.onTraceNames = [&](const std::vector<std::string>&) { headerDue = true; };
+    decoder.onSample = [&](const telemetry::Sample& s) {
+        const auto& names = decoder.getTraceNames();
+        if (headerDue) {
+            std::string header = "sequence,timeMs,overruns,skippedFrames,dropped,freeHeap,minFreeHeap,freePsram";
+            for (std::size_t i = 0; i < s.traceCount; i++) {
+                const std::string name = i < names.size() ? names[i] : fmt::format("Trace {}", i);
+                for (const char* field : {"hits", "min (us)", "max (us)", "avg (us)", "p99 (us)"}) {
+                    header += fmt::format(",\"{} {}\"", name, field);
+                }
+            }
+            std::cout << header << "\n";
+            headerDue = false;
+        }
+
+        std::string row = fmt::format(
+            "{},{},{},{},{},{},{},{}",
+            s.sequence,
+            s.timeMs,
+            s.overruns,
+            s.skippedFrames,
+            s.dropped,
+            s.freeHeap,
+            s.minFreeHeap,
+            s.freePsram);
+        for (std::size_t i = 0; i < s.traceCount; i++) {
+            const auto& t = s.traces[i];
+            row += fmt::format(",{},{},{},{},{}", t.hits, t.minUs, t.maxUs, t.avgUs, t.p99Us);
+        }
+        std::cout << row << std::endl;
+    };
+
+    constexpr int nameWidth = 30;
+    constexpr int fieldWidth = 15;
+    auto printRow = [&](const auto&... fields) {
+        std::string row;
+        bool first = true;
+        for (const std::string& field : {fmt::to_string(fields)...}) {
+            row += fmt::format("{1:<{0}}", first ? nameWidth : fieldWidth, field);
+            first = false;
+        }
+        std::cerr << row << "\n";
+    };
+    decoder.onPlacement = [&](const std::vector<telemetry::PlacementEntry>& entries) {
+        std::cerr << "Memory Placement\n";
+        printRow("Name", "Requested", "Region", "Live (B)", "Live count", "Fallbacks");
+        for (const auto& e : entries) {
+            printRow(
+                e.name,
+                memory::placementName(static_cast<memory::Placement>(e.placement)),
+                memory::regionName(static_cast<memory::Region>(e.region)),
+                e.liveBytes,
+                e.liveCount,
+                e.fallbacks);
+        }
+    };
+    decoder.onTasks = [&](const std::vector<telemetry::TaskEntry>& entries) {
+        std::cerr << "Tasks\n";
+        printRow("Task", "Core", "Priority", "Stack (B)", "Stack min free", "CPU (%)", "Missed");
+        for (const auto& e : entries) {
+            printRow(
+                e.name,
+                e.core < 0 ? std::string("Any") : std::to_string(e.core),
+                e.priority,
+                e.stackBytes,
+                e.stackFreeMin < 0 ? std::string("-") : std::to_string(e.stackFreeMin),
+                fmt::format("{:.1f}", e.intervalUs ? 100.0f * e.busyUs / e.intervalUs : 0.0f),
+                e.missed);
+        }
+    };
+    decoder.onScopedTraces = [&](const std::vector<telemetry::ScopedTraceEntry>& entries) {
+        std::cerr << "Scoped Traces\n";
+        printRow("", "Hits", "Min (us)", "Max (us)", "Avg (us)");
+        for (const auto& e : entries) { printRow(e.name, e.hits, e.minUs, e.maxUs, e.avgUs); }
+    };
+
+    std::ofstream timeline;
+    decoder.onTimelineChunk = [&](const telemetry::TimelineChunk& chunk) {
+        if (chunk.first) { timeline.open(timelinePath, std::ios::trunc); }
+        // a trace joined part way through can't be parsed, so it is skipped
+        if (!timeline.is_open()) { return; }
+        timeline << chunk.json;
+        if (chunk.last) {
+            timeline.close();
+            std::cerr << fmt::format("Timeline written to {}\n", timelinePath);
+        }
+    };
+
+    std::array<char, 256> chunk;
+    while (in.read(chunk.data(), chunk.size()) || in.gcount() > 0) {
+        decoder.feed({reinterpret_cast<const uint8_t*>(chunk.data()), static_cast<std::size_t>(in.gcount())});
+    }
+
+    std::cerr << fmt::format(
+        "{} frames, {} CRC errors, {} unsupported, {} bytes skipped\n",
+        decoder.getFrames(),
+        decoder.getCrcErrors(),
+        decoder.getUnsupportedFrames(),
+        decoder.getSkippedBytes());
+    return 0;
+}